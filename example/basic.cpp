@@ -12,12 +12,7 @@ int main(int argc, char *argv[]) {
 	// Build a random graph
 	mt19937_64 random;
 	Out_adjacency_list g;
-	for (int i = 0; i < 8; ++i)
-		g.insert_vert();
-	for (int i = 0; i < 32; ++i) {
-		auto u = g.random_vert(random), v = g.random_vert(random);
-		g.insert_edge(u, v);
-	}
+	generate_gnm(g, 8, 32, random);
 
 	// Assign edge weights
 	auto weight = g.edge_map<double>();
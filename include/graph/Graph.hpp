@@ -61,6 +61,21 @@ namespace graph {
 			struct virtual_base_called {};
 		}
 
+		// Orders in which <Graph::greedy_coloring> may consider vertices.
+		enum class Coloring_order {
+			natural,
+			largest_first,
+			smallest_last,
+		};
+
+		// Vertex orderings which <Graph::reorder> may use to improve locality.
+		enum class Reorder_policy {
+			reverse_cuthill_mckee,
+			descending_degree,
+			breadth_first,
+			gorder,
+		};
+
 		/* Generic graph interface.
 		 *
 		 * A graph is is a collection of vertices and edges between them.
@@ -347,12 +362,23 @@ namespace graph {
 			template <class Random>
 			Edge random_edge(Random& r) const;
 
+			// Samples `k` vertices uniformly and independently at random.
+			template <class Random>
+			std::vector<Vert> random_verts(Random& r, Order k) const;
+
+			// Samples `k` edges uniformly and independently at random.
+			template <class Random>
+			std::vector<Edge> random_edges(Random& r, Size k) const;
+
 			/* cldoc:end-category() */
 
 			/* cldoc:begin-category(Views) */
 
-			// Construct a view of this graph as its reverse, with reversed edge tails and heads.
+			// Construct a view of this graph as its reverse, with reversed edge tails and heads.  If this graph has only out-edges, the reverse has only in-edges, and <Out_edge_graph::bi_edge_view> may be reversed instead.
 			auto reverse_view() const;
+			// Construct a view of this graph with only the vertices kept by `vert_mask` and the edges between them kept by `edge_mask`.  Each mask is a set, such as an ephemeral set, or a predicate, such as a map to `bool` or <keep_all>.  The view refers to a mask passed as an lvalue, which must outlive it, and holds one passed as an rvalue by value.
+			template <class Vert_mask, class Edge_mask>
+			auto filtered_view(Vert_mask&& vert_mask, Edge_mask&& edge_mask) const;
 
 			// Construct a new view of this graph as an empty subforest with edges up to roots.
 			auto out_subforest() const { return _subforest<impl::traits::Out>(); }
@@ -371,6 +397,37 @@ namespace graph {
 			auto all_pairs_shortest_paths(const Weight& weight,
 				const Compare& compare = {}, const Combine& combine = {}) const;
 
+			// Counts the triangles in the simple, undirected graph underlying this one.
+			Size count_triangles() const;
+			// Computes the local clustering coefficient of each vertex in the simple, undirected graph underlying this one.
+			auto local_clustering() const;
+			// Computes the core number of each vertex in the simple, undirected graph underlying this one.
+			auto core_numbers() const;
+			// Computes the core number of each vertex in parallel.
+			auto parallel_core_numbers() const;
+			// Finds a minimum spanning forest of the undirected graph underlying this one.
+			template <class Weight, class Compare = std::less<>>
+			auto minimum_spanning_forest(const Weight& weight, const Compare& compare = {}) const;
+			// Detects communities in the simple, undirected graph underlying this one by label propagation.
+			auto communities_label_propagation() const;
+			// Detects communities in the weighted, undirected graph underlying this one with the Louvain method.
+			template <class Weight>
+			auto communities_louvain(const Weight& weight) const;
+			// Colors the simple, undirected graph underlying this one greedily, considering vertices in the given order.
+			auto greedy_coloring(Coloring_order order = Coloring_order::natural) const;
+			// Copies this graph into a stable graph with the same kinds of adjacency, relabelling the vertices in the given order and grouping the edges by tail.
+			// @return The new graph, a map from each vertex to its copy, and maps from each new vertex and edge to the original.
+			auto reorder(Reorder_policy policy = Reorder_policy::reverse_cuthill_mckee) const;
+			// Copies this graph, which may be a view, into a stable graph with the same kinds of adjacency and contiguous handles, keeping the order of vertices and gathering edges in parallel.
+			// @return The new graph, a map from each vertex to its copy, and maps from each new vertex and edge to the original.
+			auto materialize() const;
+			// Partitions the weighted, undirected graph underlying this one into `k` parts of nearly equal total vertex weight, cutting little edge weight, by multilevel recursive bisection.
+			// @return The part of each vertex, the total weight of edges between parts and the total vertex weight of each part.
+			template <class Vert_weight, class Edge_weight>
+			auto partition(Order k, const Vert_weight& vert_weight, const Edge_weight& edge_weight) const;
+			// Partitions the graph into `k` parts with unit vertex and edge weights.
+			auto partition(Order k) const;
+
 			// Construct a view of this graph which can be streamed to and from dot format.
 			template <class... Args>
 			auto dot_format(Args&&...);
@@ -454,6 +511,7 @@ namespace graph {
 			using _base_type::_base_type;
 
 			using Vert = typename _base_type::Vert;
+			using Order = typename _base_type::Order;
 			using Edge = typename _base_type::Edge;
 			using Out_degree = typename Out_edges::size_type;
 			decltype(auto) out_edges(const Vert& v) const {
@@ -462,6 +520,8 @@ namespace graph {
 			Out_degree out_degree(const Vert& v) const {
 				return Out_edges::size(this->_impl(), v);
 			}
+			// Construct a view of this graph which also has in-edges, found from a transpose of the out-edges which is built in parallel on first use and shared by copies of the view.  The transpose is a snapshot which does not follow later changes to the graph, so as with any ephemeral structure, it is undefined behavior to modify the graph during the lifetime of the view.
+			auto bi_edge_view() const;
 
 			template <class Weight, class Compare = std::less<>, class Combine = std::plus<>>
 			auto shortest_paths_from(const Vert& s, const Weight& weight,
@@ -471,6 +531,52 @@ namespace graph {
 
 			template <class WM, class Compare = std::less<>>
 			auto minimum_tree_reachable_from(const Vert& s, const WM& weight, const Compare& compare = {}) const;
+
+			// Computes the betweenness centrality of each vertex, counting each edge as a unit of length.
+			auto betweenness_centrality() const;
+			// Computes the betweenness centrality of each vertex, using the given non-negative edge weights as lengths, where edges of zero length must not form cycles.
+			template <class Weight>
+			auto betweenness_centrality(const Weight& weight) const;
+			// Estimates the betweenness centrality of each vertex from `samples` randomly chosen sources.
+			template <class Random>
+			auto betweenness_centrality(Order samples, Random& r) const;
+			// Estimates the weighted betweenness centrality of each vertex from `samples` randomly chosen sources.
+			template <class Weight, class Random>
+			auto betweenness_centrality(const Weight& weight, Order samples, Random& r) const;
+
+			// Finds a maximum matching of the bipartite graph formed by edges from vertices in `left` to vertices not in it.
+			// @return A map from each matched vertex to its matching edge, and from each other vertex to the null edge.
+			template <class Set>
+			auto maximum_bipartite_matching(const Set& left) const;
+
+			// Finds a minimum spanning forest of the undirected graph underlying this one, in parallel.
+			template <class Weight, class Compare = std::less<>>
+			auto minimum_spanning_forest(const Weight& weight, const Compare& compare = {}) const;
+
+			// Finds the arborescence with minimum total edge weights that is rooted at `s` and spans every vertex reachable from it.
+			template <class Weight, class Compare = std::less<>>
+			auto minimum_arborescence_from(const Vert& s, const Weight& weight, const Compare& compare = {}) const;
+
+			// Runs `walks_per_vert` uniform random walks of `length` steps from every vertex in parallel.
+			// @return The vertices visited by the walks, each in a block of `length + 1` padded with the null vertex if it reaches a vertex with no out-edges.
+			template <class Random>
+			auto random_walks(Order walks_per_vert, Order length, Random& r) const;
+			// Runs random walks which follow each out-edge in proportion to its non-negative weight, biased as in node2vec by return parameter `p` and in-out parameter `q`.
+			template <class Weight, class Random>
+			auto random_walks(const Weight& weight, Order walks_per_vert, Order length, Random& r, double p = 1, double q = 1) const;
+
+			// Builds a <Reachability_index> over the strongly connected components of this graph, with `traversals` interval labels and `chunks` words of hub labels per component.
+			auto reachability_index(std::size_t traversals = 2, std::size_t chunks = 1) const;
+
+			// Searches the product of this graph with `automaton`, an <Automaton> over edge labels `label(e)`, visiting only the pairs of a vertex and a state reachable from `s` and the start state.
+			// @return The vertices reached from `s` by a path whose labels the automaton accepts, in order of the fewest edges on such a path.
+			template <class Automaton, class Label>
+			auto regular_path_query(const Vert& s, const Automaton& automaton, const Label& label) const;
+			// Finds a path from `s` to `t` with minimum total edge weight among those whose labels `automaton` accepts.
+			// @return The path, or the null path if there is none.
+			template <class Automaton, class Label, class Weight, class Compare = std::less<>, class Combine = std::plus<>>
+			auto regular_shortest_path(const Vert& s, const Vert& t, const Automaton& automaton, const Label& label, const Weight& weight,
+				const Compare& compare = {}, const Combine& combine = {}) const;
 		};
 
 		template <class Impl>
@@ -535,6 +641,11 @@ namespace graph {
 			template <class WM, class Compare = std::less<>, class Combine = std::plus<>>
 			auto parallel_shortest_path(const Vert& s, const Vert& t, const WM& weight,
 				const Compare& compare = {}, const Combine& combine = {}) const -> Path;
+
+			// Finds a maximum flow from `s` to `t` subject to non-negative edge capacities.
+			// @return The value of the flow, the flow along each edge, and the side of a minimum cut containing `s`.
+			template <class Capacity>
+			auto max_flow(const Vert& s, const Vert& t, const Capacity& capacity) const;
 		};
 
 		template <class Impl>
@@ -574,10 +685,26 @@ namespace graph {
 #include "dijkstra.inl"
 #include "random.inl"
 #include "reverse.inl"
+#include "filter.inl"
 #include "subforest.inl"
 //#include "scc.inl"
 #include "floyd_warshall.inl"
+#include "triangles.inl"
+#include "cores.inl"
+#include "betweenness.inl"
+#include "max_flow.inl"
+#include "matching.inl"
+#include "spanning_forest.inl"
+#include "arborescence.inl"
+#include "communities.inl"
+#include "coloring.inl"
+#include "reorder.inl"
+#include "partition.inl"
+#include "reachability.inl"
+#include "random_walks.inl"
 #include "bidirectional_search.inl"
 #include "parallel_bidirectional_search.inl"
 #include "format.inl"
-#include "product.inl"
\ No newline at end of file
+#include "product.inl"
+#include "regular_paths.inl"
+#include "generators.inl"
\ No newline at end of file
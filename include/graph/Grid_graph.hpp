@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Graph.hpp"
+#include "impl/Grid_graph.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		// Implicit lattice of `D`-dimensional cells, each adjacent to its neighbors in either direction, whose edges are computed rather than stored.
+		template <std::size_t D>
+		using Grid_graph = Bi_edge_graph<
+			impl::Grid_graph<D>>;
+	}
+}
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <tuple>
+#include <limits>
+#include <type_traits>
+
+#include "impl/exceptions.hpp"
+#include "impl/Subforest.hpp"
+#include "impl/compact_adjacency.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			// Leftist heaps of edges in a shared pool, supporting a lazy addition to every weight in a heap.  Leftist rather than skew heaps keep the right spines, and so the recursion in <merge>, logarithmic.
+			template <class W, class Compare>
+			struct _lazy_leftist_heaps {
+				using size_type = std::size_t;
+				static constexpr size_type none = std::numeric_limits<size_type>::max();
+				struct node {
+					size_type edge;
+					W weight, delta;
+					size_type left, right, rank;
+				};
+				std::vector<node> nodes;
+				const Compare& compare;
+
+				explicit _lazy_leftist_heaps(const Compare& compare) :
+					compare(compare) {
+				}
+				size_type make(size_type edge, W weight) {
+					nodes.push_back({edge, std::move(weight), W{}, none, none, 1});
+					return nodes.size() - 1;
+				}
+				size_type rank(size_type a) const {
+					return a == none ? 0 : nodes[a].rank;
+				}
+				void propagate(size_type a) {
+					auto& n = nodes[a];
+					if (n.delta == W{})
+						return;
+					n.weight += n.delta;
+					if (n.left != none)
+						nodes[n.left].delta += n.delta;
+					if (n.right != none)
+						nodes[n.right].delta += n.delta;
+					n.delta = W{};
+				}
+				size_type merge(size_type a, size_type b) {
+					if (a == none)
+						return b;
+					if (b == none)
+						return a;
+					propagate(a);
+					propagate(b);
+					if (compare(nodes[b].weight, nodes[a].weight))
+						std::swap(a, b);
+					auto right = merge(nodes[a].right, b);
+					auto& n = nodes[a];
+					n.right = right;
+					if (rank(n.left) < rank(n.right))
+						std::swap(n.left, n.right);
+					n.rank = rank(n.right) + 1;
+					return a;
+				}
+				const node& top(size_type a) {
+					propagate(a);
+					return nodes[a];
+				}
+				void pop(size_type& a) {
+					propagate(a);
+					a = merge(nodes[a].left, nodes[a].right);
+				}
+			};
+
+			// Disjoint sets which can be rolled back to an earlier state.  Without path compression, union by size alone keeps finds logarithmic.
+			struct _rollback_union_find {
+				using size_type = std::size_t;
+				explicit _rollback_union_find(size_type size) :
+					_parent(size), _size(size, 1) {
+					for (size_type i = 0; i < size; ++i)
+						_parent[i] = i;
+				}
+				size_type find(size_type x) const {
+					while (_parent[x] != x)
+						x = _parent[x];
+					return x;
+				}
+				size_type time() const {
+					return _history.size();
+				}
+				bool unite(size_type x, size_type y) {
+					x = find(x);
+					y = find(y);
+					if (x == y)
+						return false;
+					if (_size[x] < _size[y])
+						std::swap(x, y);
+					_history.push_back(y);
+					_parent[y] = x;
+					_size[x] += _size[y];
+					return true;
+				}
+				void rollback(size_type time) {
+					while (_history.size() > time) {
+						auto y = _history.back();
+						_history.pop_back();
+						_size[_parent[y]] -= _size[y];
+						_parent[y] = y;
+					}
+				}
+			private:
+				std::vector<size_type> _parent, _size, _history;
+			};
+
+			// Tarjan's contraction algorithm for minimum arborescences, following Gabow et al. in keeping each (contracted) vertex's incoming edges in a mergeable heap.  Only the vertices marked `reachable` are spanned.
+			// @return The chosen incoming edge of each spanned vertex other than `root`.
+			template <class W, class Compare>
+			std::vector<std::size_t> _minimum_arborescence(std::size_t n, std::size_t root, const std::vector<char>& reachable,
+				const std::vector<std::size_t>& tail, const std::vector<std::size_t>& head, const std::vector<W>& weight,
+				const Compare& compare) {
+				using size_type = std::size_t;
+				using heaps_type = _lazy_leftist_heaps<W, Compare>;
+				constexpr size_type none = heaps_type::none;
+				heaps_type heaps(compare);
+				std::vector<size_type> heap(n, none);
+				for (size_type j = 0; j < tail.size(); ++j)
+					if (reachable[tail[j]] && tail[j] != head[j] && head[j] != root)
+						heap[head[j]] = heaps.merge(heap[head[j]], heaps.make(j, weight[j]));
+
+				_rollback_union_find components(n);
+				std::vector<size_type> seen(n, none), path(n), queue(n), in(n, none);
+				std::deque<std::tuple<size_type, size_type, std::vector<size_type>>> cycles;
+				seen[root] = root;
+				for (size_type s = 0; s < n; ++s) {
+					if (!reachable[s])
+						continue;
+					size_type u = s, count = 0;
+					while (seen[u] == none) {
+						check_precondition(heap[u] != none, "internal error in graph library");
+						const auto& top = heaps.top(heap[u]);
+						auto j = top.edge;
+						// Skip edges which have become internal to a contracted cycle
+						if (components.find(tail[j]) == u) {
+							heaps.pop(heap[u]);
+							continue;
+						}
+						// Reduce the weights of the remaining incoming edges by the weight of the chosen one
+						auto w = top.weight;
+						heaps.pop(heap[u]);
+						if (heap[u] != none)
+							heaps.nodes[heap[u]].delta -= w;
+						queue[count] = j;
+						path[count++] = u;
+						seen[u] = s;
+						u = components.find(tail[j]);
+						if (seen[u] == s) {
+							// Contract the cycle into a single vertex
+							size_type merged = none, end = count, time = components.time(), v;
+							do {
+								v = path[--count];
+								merged = heaps.merge(merged, heap[v]);
+							} while (components.unite(u, v));
+							u = components.find(u);
+							heap[u] = merged;
+							seen[u] = none;
+							cycles.emplace_front(u, time, std::vector<size_type>(queue.begin() + count, queue.begin() + end));
+						}
+					}
+					for (size_type i = 0; i < count; ++i)
+						in[components.find(head[queue[i]])] = queue[i];
+				}
+				// Expand the cycles in the reverse order of their contraction
+				for (auto& [u, time, cycle] : cycles) {
+					components.rollback(time);
+					auto entering = in[u];
+					for (auto j : cycle)
+						in[components.find(head[j])] = j;
+					in[components.find(head[entering])] = entering;
+				}
+				return in;
+			}
+		}
+		template <class Impl>
+		template <class Weight, class Compare>
+		auto Out_edge_graph<Impl>::minimum_arborescence_from(const Vert& s, const Weight& weight, const Compare& compare) const {
+			using W = std::decay_t<std::result_of_t<const Weight&(Edge)>>;
+			using size_type = std::size_t;
+			const auto& g = this->_impl();
+			auto index = impl::compact_index(g);
+			auto adj = impl::_compact_adjacent_edges<impl::traits::Out>(g, index);
+			const size_type n = index.size(), m = adj.size(), root = index(s);
+			std::vector<size_type> tail(m);
+			std::vector<W> weights(m);
+			for (size_type u = 0; u < n; ++u) {
+				for (auto j = adj.offsets[u]; j < adj.offsets[u + 1]; ++j) {
+					tail[j] = u;
+					weights[j] = weight(adj.edges[j]);
+				}
+			}
+			// Only the vertices reachable from the root can be spanned
+			std::vector<char> reachable(n, false);
+			std::vector<size_type> queue{root};
+			reachable[root] = true;
+			for (size_type i = 0; i < queue.size(); ++i)
+				for (auto v = adj.begin(queue[i]); v != adj.end(queue[i]); ++v)
+					if (!reachable[*v])
+						reachable[*v] = true, queue.push_back(*v);
+			auto in = impl::_minimum_arborescence(n, root, reachable, tail, adj.targets, weights, compare);
+			auto tree = impl::Subtree<impl::traits::In, Impl>(g, s);
+			for (size_type u = 0; u < n; ++u)
+				if (u != root && reachable[u])
+					tree.insert_edge(adj.edges[in[u]]);
+			return _wrap_graph(std::move(tree));
+		}
+	}
+}
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+#include "impl/exceptions.hpp"
+#include "impl/omp.hpp"
+#include "impl/compact_adjacency.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			// Per-thread scratch space for <_brandes>, which is reset after each source by walking only the vertices it reached.
+			template <class D>
+			struct _brandes_workspace {
+				std::vector<D> distance;
+				std::vector<double> paths, dependency;
+				std::vector<char> reached, closed;
+				std::vector<std::size_t> settled;
+				explicit _brandes_workspace(std::size_t n) :
+					distance(n), paths(n, 0), dependency(n, 0), reached(n, false), closed(n, false) {
+					settled.reserve(n);
+				}
+			};
+
+			// Ranks the vertices so that every zero-length edge, other than a self-edge, leads to a higher rank, which requires that such edges form no cycles.
+			template <class D>
+			std::vector<std::size_t> _zero_length_rank(const compact_adjacency& adj, const std::vector<D>& length) {
+				using size_type = compact_adjacency::size_type;
+				const size_type n = adj.order();
+				auto zero = [&](size_type u, size_type j) {
+					return adj.targets[j] != u && length[j] == D{};
+				};
+				std::vector<size_type> pending(n, 0), order, rank(n);
+				for (size_type u = 0; u < n; ++u)
+					for (auto j = adj.offsets[u]; j < adj.offsets[u + 1]; ++j)
+						if (zero(u, j))
+							++pending[adj.targets[j]];
+				order.reserve(n);
+				for (size_type u = 0; u < n; ++u)
+					if (!pending[u])
+						order.push_back(u);
+				for (size_type k = 0; k < order.size(); ++k) {
+					auto u = order[k];
+					rank[u] = k;
+					for (auto j = adj.offsets[u]; j < adj.offsets[u + 1]; ++j)
+						if (zero(u, j) && !--pending[adj.targets[j]])
+							order.push_back(adj.targets[j]);
+				}
+				check_precondition(order.size() == n, "edges of zero length must not form cycles");
+				return rank;
+			}
+
+			// Brandes' algorithm from each of `sources`, which searches breadth-first if `length` is empty and with Dijkstra's algorithm otherwise, in which case `rank` orders vertices joined by zero-length edges.  Each thread accumulates into its own array, and these are reduced at the end.
+			template <class D>
+			std::vector<double> _brandes(const compact_adjacency& adj, const std::vector<D>& length,
+				const std::vector<std::size_t>& rank, const std::vector<std::size_t>& sources) {
+				using size_type = compact_adjacency::size_type;
+				const size_type n = adj.order();
+				const bool weighted = !length.empty();
+				std::vector<double> centrality(n, 0);
+				#pragma omp parallel
+				{
+					_brandes_workspace<D> w(n);
+					std::vector<double> local(n, 0);
+					using pair_type = std::pair<D, size_type>;
+					std::priority_queue<pair_type, std::vector<pair_type>, std::greater<>> queue;
+					#pragma omp for schedule(dynamic, 1)
+					for (size_type i = 0; i < sources.size(); ++i) {
+						auto s = sources[i];
+						w.distance[s] = D{};
+						w.paths[s] = 1;
+						if (weighted) {
+							w.reached[s] = true;
+							queue.emplace(D{}, s);
+							while (!queue.empty()) {
+								auto [d, u] = queue.top();
+								queue.pop();
+								if (w.closed[u])
+									continue;
+								w.closed[u] = true;
+								w.settled.push_back(u);
+								for (auto j = adj.offsets[u]; j < adj.offsets[u + 1]; ++j) {
+									auto v = adj.targets[j];
+									if (v == u || w.closed[v])
+										continue;
+									auto c = d + length[j];
+									if (!w.reached[v] || c < w.distance[v]) {
+										w.reached[v] = true;
+										w.distance[v] = c;
+										queue.emplace(c, v);
+									}
+								}
+							}
+							// Vertices at equal distance may be settled in any order, so they are reordered to follow their predecessors along zero-length edges before paths are counted
+							for (size_type begin = 0, end = 0; begin < w.settled.size(); begin = end) {
+								while (end < w.settled.size() && w.distance[w.settled[end]] == w.distance[w.settled[begin]])
+									++end;
+								std::sort(w.settled.begin() + begin, w.settled.begin() + end,
+									[&rank](size_type l, size_type r) { return rank[l] < rank[r]; });
+							}
+							for (auto u : w.settled)
+								for (auto j = adj.offsets[u]; j < adj.offsets[u + 1]; ++j) {
+									auto v = adj.targets[j];
+									if (v != u && w.distance[v] == w.distance[u] + length[j])
+										w.paths[v] += w.paths[u];
+								}
+						} else {
+							// The settled vertices double as the breadth-first queue
+							w.settled.push_back(s);
+							for (size_type k = 0; k < w.settled.size(); ++k) {
+								auto u = w.settled[k];
+								for (auto v = adj.begin(u); v != adj.end(u); ++v) {
+									if (!w.paths[*v]) {
+										w.distance[*v] = w.distance[u] + 1;
+										w.settled.push_back(*v);
+									}
+									if (w.distance[*v] == w.distance[u] + 1)
+										w.paths[*v] += w.paths[u];
+								}
+							}
+						}
+						// Accumulate dependencies in reverse order of distance by scanning the successors of each vertex
+						for (auto k = w.settled.size(); k-- > 0;) {
+							auto u = w.settled[k];
+							double dependency = 0;
+							for (auto j = adj.offsets[u]; j < adj.offsets[u + 1]; ++j) {
+								auto v = adj.targets[j];
+								if (v == u || !w.paths[v])
+									continue;
+								if (weighted ? w.distance[v] == w.distance[u] + length[j] : w.distance[v] == w.distance[u] + 1)
+									dependency += w.paths[u] / w.paths[v] * (1 + w.dependency[v]);
+							}
+							w.dependency[u] = dependency;
+							if (u != s)
+								local[u] += dependency;
+						}
+						for (auto u : w.settled) {
+							w.paths[u] = w.dependency[u] = 0;
+							w.reached[u] = w.closed[u] = false;
+						}
+						w.settled.clear();
+					}
+					#pragma omp critical
+					for (size_type u = 0; u < n; ++u)
+						centrality[u] += local[u];
+				}
+				return centrality;
+			}
+
+			// Chooses `samples` distinct sources uniformly at random, or every vertex if there are no more vertices than that.
+			template <class Random>
+			std::vector<std::size_t> _sample_sources(std::size_t n, std::size_t samples, Random* r) {
+				std::vector<std::size_t> sources(n);
+				std::iota(sources.begin(), sources.end(), 0);
+				if (!r || samples >= n)
+					return sources;
+				for (std::size_t i = 0; i < samples; ++i)
+					std::swap(sources[i], sources[std::uniform_int_distribution<std::size_t>(i, n - 1)(*r)]);
+				sources.resize(samples);
+				return sources;
+			}
+
+			template <class G, class Weight, class Random>
+			auto _betweenness_centrality(const G& g, const Weight* weight, std::size_t samples, Random* r) {
+				auto index = compact_index(g._impl());
+				auto adj = _compact_adjacent_edges<traits::Out>(g._impl(), index);
+				auto sources = _sample_sources(index.size(), samples, r);
+				std::vector<double> centrality;
+				if constexpr (std::is_same_v<Weight, void>) {
+					centrality = _brandes(adj, std::vector<std::size_t>{}, {}, sources);
+				} else {
+					using D = std::decay_t<std::result_of_t<const Weight&(Edge<G>)>>;
+					std::vector<D> length(adj.size());
+					for (std::size_t j = 0; j < adj.size(); ++j) {
+						length[j] = (*weight)(adj.edges[j]);
+						check_precondition(!(length[j] < D{}), "edges must have non-negative weights");
+					}
+					centrality = _brandes(adj, length, _zero_length_rank(adj, length), sources);
+				}
+				// Scale up sampled estimates so they are unbiased
+				double scale = sources.empty() ? 1.0 : static_cast<double>(index.size()) / sources.size();
+				auto result = g.vert_map(0.0);
+				for (std::size_t u = 0; u < index.size(); ++u)
+					result[index[u]] = scale * centrality[u];
+				return result;
+			}
+		}
+		template <class Impl>
+		auto Out_edge_graph<Impl>::betweenness_centrality() const {
+			return impl::_betweenness_centrality(*this, static_cast<const void*>(nullptr), 0, static_cast<std::mt19937*>(nullptr));
+		}
+		template <class Impl>
+		template <class Weight>
+		auto Out_edge_graph<Impl>::betweenness_centrality(const Weight& weight) const {
+			return impl::_betweenness_centrality(*this, &weight, 0, static_cast<std::mt19937*>(nullptr));
+		}
+		template <class Impl>
+		template <class Random>
+		auto Out_edge_graph<Impl>::betweenness_centrality(Order samples, Random& r) const {
+			return impl::_betweenness_centrality(*this, static_cast<const void*>(nullptr), samples, &r);
+		}
+		template <class Impl>
+		template <class Weight, class Random>
+		auto Out_edge_graph<Impl>::betweenness_centrality(const Weight& weight, Order samples, Random& r) const {
+			return impl::_betweenness_centrality(*this, &weight, samples, &r);
+		}
+	}
+}
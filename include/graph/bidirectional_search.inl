@@ -14,6 +14,29 @@
 namespace graph {
 	inline namespace v1 {
 		namespace impl {
+			// Splices the path through `rendezvous` from the trees of a bidirectional search, gathering the edges of each half in a single walk so the path owns them and does not refer to the trees.
+			template <class G, class S_tree, class T_tree>
+			Path<G> _splice_tree_paths(const G& g, const S_tree& s_tree, const T_tree& t_tree, const typename Path<G>::Vert& rendezvous) {
+				using Vert = typename Path<G>::Vert;
+				using Edges = typename Path<G>::Edges;
+				std::vector<typename Path<G>::Edge> edges;
+				auto walk = [&](auto step, bool reversed) {
+					auto v = rendezvous;
+					for (auto e = step(v); e != Edges::null(g); e = step(v)) {
+#if GRAPH_CHECK_PRECONDITIONS
+						check_precondition(edges.size() < Path<G>::Verts::size(g), "forest must be acyclic");
+#endif
+						edges.push_back(e);
+						v = reversed ? Edges::tail(g, e) : Edges::head(g, e);
+					}
+					return v;
+				};
+				auto source = walk([&](const Vert& v) { return s_tree.in_edge_or_null(v); }, true);
+				std::reverse(edges.begin(), edges.end());
+				walk([&](const Vert& v) { return t_tree.out_edge_or_null(v); }, false);
+				return Path<G>(g, std::move(source), std::move(edges));
+			}
+
 			template <class Adjacency, class G, class Queue,
 				class Near, class Far,
 				class Weight, class Distance, class Tree,
@@ -111,9 +134,7 @@ namespace graph {
 				compare, total_distance);
 
 			// Construct path from trees
-			return this->concatenate_paths(
-				s_tree.path_from_root_to(rendezvous),
-				t_tree.path_to_root_from(rendezvous));
+			return impl::_splice_tree_paths(this->_impl(), s_tree, t_tree, rendezvous);
 		}
 	}
 }
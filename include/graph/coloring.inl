@@ -0,0 +1,114 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <numeric>
+#include <algorithm>
+
+#include "impl/omp.hpp"
+#include "impl/compact_adjacency.hpp"
+#include "impl/parallel_sort.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			// Speculative parallel greedy coloring.  Each round, the pending vertices are colored in parallel with the smallest color unused by their neighbors, and then any vertex sharing a color with a neighbor earlier in `order` is queued for the next round.
+			inline std::vector<std::size_t> _greedy_coloring(const compact_adjacency& adj, const std::vector<std::size_t>& order) {
+				using size_type = std::size_t;
+				const size_type n = adj.order();
+				std::vector<size_type> rank(n);
+				#pragma omp parallel for
+				for (size_type i = 0; i < n; ++i)
+					rank[order[i]] = i;
+				size_type max_degree = 0;
+				for (size_type u = 0; u < n; ++u)
+					max_degree = std::max(max_degree, adj.degree(u));
+				std::vector<std::atomic<size_type>> color(n);
+				#pragma omp parallel for
+				for (size_type u = 0; u < n; ++u)
+					color[u].store(n, std::memory_order_relaxed);
+				std::vector<size_type> pending(order), conflicts;
+				while (!pending.empty()) {
+					#pragma omp parallel
+					{
+						// Colors forbidden to the current vertex are stamped with it, so the array never needs clearing
+						std::vector<size_type> forbidden(max_degree + 1, n);
+						#pragma omp for schedule(static, 256)
+						for (size_type i = 0; i < pending.size(); ++i) {
+							auto u = pending[i];
+							for (auto v = adj.begin(u); v != adj.end(u); ++v) {
+								auto c = color[*v].load(std::memory_order_relaxed);
+								if (c <= max_degree)
+									forbidden[c] = u;
+							}
+							size_type c = 0;
+							while (forbidden[c] == u)
+								++c;
+							color[u].store(c, std::memory_order_relaxed);
+						}
+					}
+					conflicts.clear();
+					#pragma omp parallel
+					{
+						std::vector<size_type> local;
+						#pragma omp for schedule(static, 256) nowait
+						for (size_type i = 0; i < pending.size(); ++i) {
+							auto u = pending[i];
+							auto c = color[u].load(std::memory_order_relaxed);
+							for (auto v = adj.begin(u); v != adj.end(u); ++v) {
+								if (rank[*v] < rank[u] && color[*v].load(std::memory_order_relaxed) == c) {
+									local.push_back(u);
+									break;
+								}
+							}
+						}
+						#pragma omp critical
+						conflicts.insert(conflicts.end(), local.begin(), local.end());
+					}
+					// Keep the pending vertices in order so the earliest of any conflicting pair wins again
+					std::sort(conflicts.begin(), conflicts.end(), [&](size_type l, size_type r) {
+						return rank[l] < rank[r];
+					});
+					// Uncolor the conflicting vertices so they are not counted against one another
+					for (auto u : conflicts)
+						color[u].store(n, std::memory_order_relaxed);
+					pending.swap(conflicts);
+				}
+				std::vector<size_type> result(n);
+				for (size_type u = 0; u < n; ++u)
+					result[u] = color[u].load(std::memory_order_relaxed);
+				return result;
+			}
+		}
+		template <class Impl>
+		auto Graph<Impl>::greedy_coloring(Coloring_order policy) const {
+			using size_type = std::size_t;
+			auto index = impl::compact_index(this->_impl());
+			auto adj = impl::_compact_neighbors(this->_impl(), index);
+			const size_type n = index.size();
+			std::vector<size_type> order(n);
+			switch (policy) {
+			case Coloring_order::natural:
+				std::iota(order.begin(), order.end(), 0);
+				break;
+			case Coloring_order::largest_first:
+				std::iota(order.begin(), order.end(), 0);
+				impl::_parallel_sort(order, [&](size_type l, size_type r) {
+					auto dl = adj.degree(l), dr = adj.degree(r);
+					return dl > dr || (dl == dr && l < r);
+				});
+				break;
+			case Coloring_order::smallest_last:
+				// Color in the reverse of the order in which vertices are peeled by degree
+				order = impl::_peel_cores(adj).second;
+				std::reverse(order.begin(), order.end());
+				break;
+			}
+			auto color = impl::_greedy_coloring(adj, order);
+			auto result = vert_map(Order{});
+			for (size_type u = 0; u < n; ++u)
+				result[index[u]] = static_cast<Order>(color[u]);
+			return result;
+		}
+	}
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <numeric>
+#include <algorithm>
+
+#include "impl/omp.hpp"
+#include "impl/compact_adjacency.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			// Renumbers `labels` onto `[0, count)` in order of first appearance.
+			// @return The number of distinct labels.
+			inline std::size_t _dense_labels(std::vector<std::size_t>& labels) {
+				using size_type = std::size_t;
+				const size_type none = labels.size();
+				std::vector<size_type> renumber(labels.size(), none);
+				size_type count = 0;
+				for (auto& l : labels) {
+					if (renumber[l] == none)
+						renumber[l] = count++;
+					l = renumber[l];
+				}
+				return count;
+			}
+
+			// Asynchronous label propagation, in which each vertex repeatedly adopts the most frequent label among its neighbors until no label changes.
+			inline std::vector<std::size_t> _label_propagation(const compact_adjacency& adj, std::size_t max_rounds) {
+				using size_type = std::size_t;
+				const size_type n = adj.order();
+				std::vector<std::atomic<size_type>> labels(n);
+				#pragma omp parallel for
+				for (size_type u = 0; u < n; ++u)
+					labels[u].store(u, std::memory_order_relaxed);
+				for (size_type round = 0; round < max_rounds; ++round) {
+					size_type changed = 0;
+					#pragma omp parallel reduction(+:changed)
+					{
+						sparse_accumulator<size_type> count(n);
+						#pragma omp for schedule(dynamic, 256)
+						for (size_type u = 0; u < n; ++u) {
+							if (!adj.degree(u))
+								continue;
+							for (auto v = adj.begin(u); v != adj.end(u); ++v)
+								count.add(labels[*v].load(std::memory_order_relaxed), 1);
+							// Prefer the current label, then the smallest, among the most frequent
+							auto current = labels[u].load(std::memory_order_relaxed), best = current;
+							size_type best_count = count.values[current];
+							for (auto l : count.touched)
+								if (count.values[l] > best_count || (count.values[l] == best_count && best != current && l < best))
+									best = l, best_count = count.values[l];
+							count.clear();
+							if (best != current) {
+								labels[u].store(best, std::memory_order_relaxed);
+								++changed;
+							}
+						}
+					}
+					if (!changed)
+						break;
+				}
+				std::vector<size_type> result(n);
+				for (size_type u = 0; u < n; ++u)
+					result[u] = labels[u].load(std::memory_order_relaxed);
+				return result;
+			}
+
+			// One level of parallel Louvain local moves, each of which greedily moves a vertex to the neighboring community with the largest modularity gain.
+			// @return Whether any vertex moved.
+			inline bool _louvain_move(const compact_weighted_adjacency<double>& adj, std::vector<std::atomic<std::size_t>>& community,
+				std::size_t max_passes) {
+				using size_type = std::size_t;
+				const size_type n = adj.order();
+				std::vector<double> degree(n), total(n);
+				std::vector<size_type> size(n, 1);
+				double m2 = 0;
+				#pragma omp parallel for reduction(+:m2)
+				for (size_type u = 0; u < n; ++u) {
+					degree[u] = std::accumulate(adj.weights.begin() + adj.offsets[u], adj.weights.begin() + adj.offsets[u + 1], 0.0);
+					total[u] = degree[u];
+					community[u].store(u, std::memory_order_relaxed);
+					m2 += degree[u];
+				}
+				if (!(m2 > 0))
+					return false;
+				bool moved = false;
+				for (size_type pass = 0; pass < max_passes; ++pass) {
+					size_type moves = 0;
+					#pragma omp parallel reduction(+:moves)
+					{
+						sparse_accumulator<double> link(n);
+						#pragma omp for schedule(dynamic, 256)
+						for (size_type u = 0; u < n; ++u) {
+							auto c = community[u].load(std::memory_order_relaxed);
+							for (auto j = adj.offsets[u]; j < adj.offsets[u + 1]; ++j)
+								if (adj.targets[j] != u)
+									link.add(community[adj.targets[j]].load(std::memory_order_relaxed), adj.weights[j]);
+							double current_total;
+							#pragma omp atomic read
+							current_total = total[c];
+							auto scale = degree[u] / m2;
+							auto best = c;
+							auto best_gain = link.values[c] - (current_total - degree[u]) * scale;
+							for (auto d : link.touched) {
+								if (d == c)
+									continue;
+								double d_total;
+								size_type c_size, d_size;
+								#pragma omp atomic read
+								d_total = total[d];
+								#pragma omp atomic read
+								c_size = size[c];
+								#pragma omp atomic read
+								d_size = size[d];
+								// Two singletons could otherwise swap communities forever
+								if (c_size == 1 && d_size == 1 && d > c)
+									continue;
+								auto gain = link.values[d] - d_total * scale;
+								if (gain > best_gain || (gain == best_gain && best != c && d < best))
+									best = d, best_gain = gain;
+							}
+							link.clear();
+							if (best == c)
+								continue;
+							#pragma omp atomic
+							total[c] -= degree[u];
+							#pragma omp atomic
+							total[best] += degree[u];
+							#pragma omp atomic
+							--size[c];
+							#pragma omp atomic
+							++size[best];
+							community[u].store(best, std::memory_order_relaxed);
+							++moves;
+						}
+					}
+					if (!moves)
+						break;
+					moved = true;
+				}
+				return moved;
+			}
+
+			// Multilevel Louvain: local moves until they stop paying off, then aggregation of communities into vertices, repeated until no vertex moves.
+			inline std::vector<std::size_t> _louvain(compact_weighted_adjacency<double> adj, std::size_t max_passes) {
+				using size_type = std::size_t;
+				std::vector<size_type> assignment(adj.order());
+				std::iota(assignment.begin(), assignment.end(), 0);
+				for (;;) {
+					const size_type n = adj.order();
+					std::vector<std::atomic<size_type>> community(n);
+					if (!_louvain_move(adj, community, max_passes))
+						break;
+					std::vector<size_type> level(n);
+					for (size_type u = 0; u < n; ++u)
+						level[u] = community[u].load(std::memory_order_relaxed);
+					auto count = _dense_labels(level);
+					#pragma omp parallel for
+					for (size_type i = 0; i < assignment.size(); ++i)
+						assignment[i] = level[assignment[i]];
+					if (count == n)
+						break;
+					adj = _aggregate_weighted_adjacency(adj, level, count);
+				}
+				_dense_labels(assignment);
+				return assignment;
+			}
+		}
+		template <class Impl>
+		auto Graph<Impl>::communities_label_propagation() const {
+			auto index = impl::compact_index(this->_impl());
+			auto labels = impl::_label_propagation(impl::_compact_neighbors(this->_impl(), index), 100);
+			impl::_dense_labels(labels);
+			auto result = vert_map(Order{});
+			for (std::size_t u = 0; u < index.size(); ++u)
+				result[index[u]] = static_cast<Order>(labels[u]);
+			return result;
+		}
+		template <class Impl>
+		template <class Weight>
+		auto Graph<Impl>::communities_louvain(const Weight& weight) const {
+			auto index = impl::compact_index(this->_impl());
+			auto community = impl::_louvain(impl::_compact_weighted_neighbors<double>(this->_impl(), index, weight), 32);
+			auto result = vert_map(Order{});
+			for (std::size_t u = 0; u < index.size(); ++u)
+				result[index[u]] = static_cast<Order>(community[u]);
+			return result;
+		}
+	}
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+#include "impl/omp.hpp"
+#include "impl/compact_adjacency.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			// Batagelj-Zaversnik peeling of a simple, undirected graph.  Vertices are kept sorted by their current degree in `order`, with `bin` holding the start of each degree's run and `position` the inverse of `order`, so each removal is a constant-time swap.
+			// @return The core number of each vertex, and the order in which vertices were peeled (which is a smallest-last ordering).
+			inline std::pair<std::vector<std::size_t>, std::vector<std::size_t>>
+			_peel_cores(const compact_adjacency& adj) {
+				using size_type = compact_adjacency::size_type;
+				const size_type n = adj.order();
+				std::vector<size_type> degree(n), order(n), position(n);
+				size_type max_degree = 0;
+				for (size_type u = 0; u < n; ++u)
+					max_degree = std::max(max_degree, degree[u] = adj.degree(u));
+				std::vector<size_type> bin(max_degree + 1, 0);
+				for (size_type u = 0; u < n; ++u)
+					++bin[degree[u]];
+				for (size_type d = 0, start = 0; d <= max_degree; ++d)
+					start += std::exchange(bin[d], start);
+				for (size_type u = 0; u < n; ++u) {
+					position[u] = bin[degree[u]]++;
+					order[position[u]] = u;
+				}
+				for (size_type d = max_degree; d > 0; --d)
+					bin[d] = bin[d - 1];
+				if (n)
+					bin[0] = 0;
+				for (size_type i = 0; i < n; ++i) {
+					auto u = order[i];
+					for (auto v = adj.begin(u); v != adj.end(u); ++v) {
+						if (degree[*v] <= degree[u])
+							continue;
+						// Swap `v` to the front of its bin and shrink the bin past it
+						auto dv = degree[*v], pv = position[*v], pw = bin[dv];
+						auto w = order[pw];
+						if (w != *v) {
+							std::swap(order[pv], order[pw]);
+							position[*v] = pw;
+							position[w] = pv;
+						}
+						++bin[dv];
+						--degree[*v];
+					}
+				}
+				return std::make_pair(std::move(degree), std::move(order));
+			}
+
+			// Level-synchronous peeling of a simple, undirected graph.  Every vertex whose remaining degree is at most the current level is removed in a parallel round, and neighbors falling to the level join the next round.  Neighbors left above the level are pushed to the bucket of their new degree, which seeds that level, so no round scans all vertices.  Stale bucket entries, for vertices since removed or decremented again, are skipped.
+			inline std::vector<std::size_t> _parallel_peel_cores(const compact_adjacency& adj) {
+				using size_type = compact_adjacency::size_type;
+				const size_type n = adj.order();
+				std::vector<size_type> degree(n), frontier;
+				std::vector<char> removed(n, false);
+				size_type max_degree = 0;
+				#pragma omp parallel for reduction(max:max_degree)
+				for (size_type u = 0; u < n; ++u)
+					max_degree = std::max(max_degree, degree[u] = adj.degree(u));
+				std::vector<std::vector<size_type>> buckets(max_degree + 1);
+				for (size_type u = 0; u < n; ++u)
+					buckets[degree[u]].push_back(u);
+				// Every remaining vertex has degree at least the level, so each level starts from its bucket
+				for (size_type level = 0, remaining = n; remaining; ++level) {
+					frontier.clear();
+					for (auto u : buckets[level])
+						if (!removed[u] && degree[u] == level)
+							frontier.push_back(u);
+					std::vector<size_type>().swap(buckets[level]);
+					while (!frontier.empty()) {
+						remaining -= frontier.size();
+						for (auto u : frontier)
+							removed[u] = true;
+						std::vector<size_type> next;
+						#pragma omp parallel
+						{
+							std::vector<size_type> local;
+							std::vector<std::pair<size_type, size_type>> moved;
+							#pragma omp for schedule(dynamic, 64) nowait
+							for (size_type i = 0; i < frontier.size(); ++i) {
+								auto u = frontier[i];
+								degree[u] = level;
+								for (auto v = adj.begin(u); v != adj.end(u); ++v) {
+									if (removed[*v])
+										continue;
+									size_type old;
+									#pragma omp atomic capture
+									old = degree[*v]--;
+									// Only the decrement which crosses onto the level enqueues the neighbor
+									if (old == level + 1)
+										local.push_back(*v);
+									else if (old > level + 1)
+										moved.emplace_back(old - 1, *v);
+								}
+							}
+							#pragma omp critical
+							{
+								next.insert(next.end(), local.begin(), local.end());
+								for (const auto& [d, v] : moved)
+									buckets[d].push_back(v);
+							}
+						}
+						frontier = std::move(next);
+					}
+				}
+				return degree;
+			}
+		}
+		template <class Impl>
+		auto Graph<Impl>::core_numbers() const {
+			auto index = impl::compact_index(this->_impl());
+			auto [core, order] = impl::_peel_cores(impl::_compact_neighbors(this->_impl(), index));
+			auto result = vert_map(Order{});
+			for (std::size_t u = 0; u < index.size(); ++u)
+				result[index[u]] = static_cast<Order>(core[u]);
+			return result;
+		}
+		template <class Impl>
+		auto Graph<Impl>::parallel_core_numbers() const {
+			auto index = impl::compact_index(this->_impl());
+			auto core = impl::_parallel_peel_cores(impl::_compact_neighbors(this->_impl(), index));
+			auto result = vert_map(Order{});
+			for (std::size_t u = 0; u < index.size(); ++u)
+				result[index[u]] = static_cast<Order>(core[u]);
+			return result;
+		}
+	}
+}
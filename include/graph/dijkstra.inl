@@ -11,13 +11,22 @@
 namespace graph {
 	inline namespace v1 {
 		namespace impl {
-			template <class Adjacency, class G, class Weight, class Compare, class Combine, class D>
+			// Never stops a search early.
+			struct _never_fn {
+				template <class V>
+				constexpr bool operator()(const V&) const noexcept {
+					return false;
+				}
+			};
+
+			// Dijkstra's algorithm from `s`, which stops as soon as it settles a vertex `v` for which `stop(v)`.
+			template <class Adjacency, class G, class Weight, class Compare, class Combine, class D, class Stop = _never_fn>
 			std::pair<
 				Subtree<traits::Reverse_adjacency<Adjacency>, G>,
 				Vert_map<G, D>>
 			_dijkstra(const G& g, Vert<G> s, const Weight& weight,
 				const Compare& compare, const Combine& combine,
-				D zero, D inf) {
+				D zero, D inf, const Stop& stop = {}) {
 				using Verts = traits::Verts<G>;
 				auto closed = Verts::ephemeral_set(g);
 				auto tree = Subtree<traits::Reverse_adjacency<Adjacency>, G>(g, s);
@@ -38,6 +47,8 @@ namespace graph {
 					queue.pop();
 					if (!closed.insert(v))
 						continue;
+					if (stop(v))
+						break;
 					for (auto e : traits::Adjacent_edges<Adjacency, G>::range(g, v)) {
 						auto u = traits::adjacency_cokey<Adjacency, G>(g, e);
 #if !GRAPH_CHECK_PRECONDITIONS
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "impl/Filtered.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		// Mask for <Graph::filtered_view> which keeps every vertex or edge.
+		inline constexpr impl::keep_all_fn keep_all{};
+
+		template <class Impl>
+		template <class Vert_mask, class Edge_mask>
+		auto Graph<Impl>::filtered_view(Vert_mask&& vert_mask, Edge_mask&& edge_mask) const {
+			using Filtered = impl::Filtered<const Impl *, impl::_held_mask_t<Vert_mask>, impl::_held_mask_t<Edge_mask>>;
+			return _wrap_graph(Filtered(&this->_impl(), std::forward<Vert_mask>(vert_mask), std::forward<Edge_mask>(edge_mask)));
+		}
+	}
+}
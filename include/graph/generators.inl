@@ -0,0 +1,204 @@
+#pragma once
+
+#include <vector>
+#include <array>
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <optional>
+#include <type_traits>
+
+#include "impl/exceptions.hpp"
+#include "impl/omp.hpp"
+#include "impl/splitmix64.hpp"
+#include "impl/compact_adjacency.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			template <class G, class = void>
+			struct _has_atomic_insert : std::false_type {};
+			template <class G>
+			struct _has_atomic_insert<G, std::void_t<
+				decltype(std::declval<G&>().reserve_verts(std::declval<typename G::Order>())),
+				decltype(std::declval<G&>().reserve_edges(std::declval<typename G::Size>())),
+				decltype(std::declval<G&>().atomic_insert_vert()),
+				decltype(std::declval<G&>().atomic_insert_edge(std::declval<typename G::Vert>(), std::declval<typename G::Vert>()))>> :
+				std::true_type {};
+
+			// Inserts `n` new vertices.  This is done serially, which is cheap next to inserting edges, so that the `i`th new vertex is the same however many threads insert the edges.
+			// @return The new vertices.
+			template <class G>
+			auto _generate_verts(G& g, std::size_t n) {
+				using size_type = std::size_t;
+				if constexpr (_has_atomic_insert<G>{})
+					g.reserve_verts(g.order() + n);
+				std::vector<typename G::Vert> verts;
+				verts.reserve(n);
+				for (size_type i = 0; i < n; ++i)
+					verts.push_back(g.insert_vert());
+				return verts;
+			}
+
+			// Inserts the edges emitted by `generate(block, emit)` for each block in `[0, blocks)`, where `emit(u, v)` inserts an edge from `verts[u]` to `verts[v]`.  If the graph supports atomic insertion, the blocks are generated in parallel, first only counting the edges if their number, `size`, is not known in advance.  Each block must therefore emit the same edges every time it is generated.
+			template <class G, class Vert, class Generate>
+			void _generate_edges(G& g, const std::vector<Vert>& verts, std::size_t blocks, std::optional<std::size_t> size,
+				const Generate& generate) {
+				using size_type = std::size_t;
+				if constexpr (_has_atomic_insert<G>{}) {
+					if (!size) {
+						size_type count = 0;
+						#pragma omp parallel for schedule(dynamic, 64) reduction(+:count)
+						for (size_type b = 0; b < blocks; ++b)
+							generate(b, [&](size_type, size_type) { ++count; });
+						size = count;
+					}
+					g.reserve_edges(g.size() + *size);
+					#pragma omp parallel for schedule(dynamic, 64)
+					for (size_type b = 0; b < blocks; ++b)
+						generate(b, [&](size_type u, size_type v) { g.atomic_insert_edge(verts[u], verts[v]); });
+				} else {
+					for (size_type b = 0; b < blocks; ++b)
+						generate(b, [&](size_type u, size_type v) { g.insert_edge(verts[u], verts[v]); });
+				}
+			}
+
+			// Number of edges generated together by a single stream
+			constexpr std::size_t _generator_block_size = 1 << 14;
+
+			template <class Random>
+			std::uint64_t _generator_seed(Random& r) {
+				return std::uniform_int_distribution<std::uint64_t>{}(r);
+			}
+		}
+
+		// Inserts `n` vertices with an edge between each ordered pair of distinct vertices independently with probability `p`.  Each vertex skips geometrically distributed runs of non-neighbors, so the work is proportional to the number of edges.
+		template <class Impl, class Random>
+		void generate_gnp(Graph<Impl>& g, std::size_t n, double p, Random& r) {
+			impl::check_precondition(p >= 0 && p <= 1, "probability must be between zero and one");
+			auto verts = impl::_generate_verts(g, n);
+			if (n < 2 || p == 0)
+				return;
+			const auto seed = impl::_generator_seed(r);
+			const double log_q = std::log1p(-p);
+			impl::_generate_edges(g, verts, n, std::nullopt, [&](std::size_t u, auto&& emit) {
+				auto stream = impl::_splitmix64::stream(seed, u);
+				for (std::size_t i = 0;; ++i) {
+					if (p < 1) {
+						// The number of failures before the next success, where the uniform deviate is drawn from `(0, 1]`
+						auto skip = std::floor(std::log1p(-stream.uniform()) / log_q);
+						if (!(skip < static_cast<double>(n - 1 - i)))
+							break;
+						i += static_cast<std::size_t>(skip);
+					}
+					if (i >= n - 1)
+						break;
+					emit(u, i < u ? i : i + 1);
+				}
+			});
+		}
+
+		// Inserts `n` vertices and `m` edges between independently and uniformly chosen vertices, which may include self-edges and parallel edges.
+		template <class Impl, class Random>
+		void generate_gnm(Graph<Impl>& g, std::size_t n, std::size_t m, Random& r) {
+			impl::check_precondition(n > 0 || m == 0, "edges require vertices");
+			auto verts = impl::_generate_verts(g, n);
+			const auto seed = impl::_generator_seed(r);
+			constexpr auto block_size = impl::_generator_block_size;
+			impl::_generate_edges(g, verts, (m + block_size - 1) / block_size, m, [&](std::size_t b, auto&& emit) {
+				auto stream = impl::_splitmix64::stream(seed, b);
+				for (auto i = b * block_size; i < std::min(m, (b + 1) * block_size); ++i) {
+					auto u = stream.below(n);
+					emit(u, stream.below(n));
+				}
+			});
+		}
+
+		// Inserts `2^scale` vertices and `m` edges by the recursive matrix (R-MAT) model, in which each edge descends `scale` times into one of the quadrants of the adjacency matrix with probabilities `a`, `b`, `c` and `1 - a - b - c`.
+		template <class Impl, class Random>
+		void generate_rmat(Graph<Impl>& g, unsigned scale, std::size_t m, double a, double b, double c, Random& r) {
+			impl::check_precondition(a >= 0 && b >= 0 && c >= 0 && a + b + c <= 1, "quadrant probabilities must form a distribution");
+			impl::check_precondition(scale < 8 * sizeof(std::size_t), "scale is too large");
+			auto verts = impl::_generate_verts(g, std::size_t{1} << scale);
+			const auto seed = impl::_generator_seed(r);
+			constexpr auto block_size = impl::_generator_block_size;
+			impl::_generate_edges(g, verts, (m + block_size - 1) / block_size, m, [&](std::size_t block, auto&& emit) {
+				auto stream = impl::_splitmix64::stream(seed, block);
+				for (auto i = block * block_size; i < std::min(m, (block + 1) * block_size); ++i) {
+					std::size_t u = 0, v = 0;
+					for (unsigned level = 0; level < scale; ++level) {
+						auto x = stream.uniform();
+						u = 2 * u + (x >= a + b);
+						v = 2 * v + ((x >= a && x < a + b) || x >= a + b + c);
+					}
+					emit(u, v);
+				}
+			});
+		}
+
+		// Inserts `n` vertices, each with `k` edges to earlier vertices chosen by preferential attachment.  Following Batagelj and Brandes, the head of each edge copies an endpoint of a uniformly chosen earlier edge, which may produce self-edges and parallel edges.  Following Sanders and Schulz, each such choice is a hash of its position, so the edges can be generated independently in parallel.
+		template <class Impl, class Random>
+		void generate_barabasi_albert(Graph<Impl>& g, std::size_t n, std::size_t k, Random& r) {
+			auto verts = impl::_generate_verts(g, n);
+			const auto seed = impl::_generator_seed(r);
+			const std::size_t m = n * k;
+			constexpr auto block_size = impl::_generator_block_size;
+			impl::_generate_edges(g, verts, (m + block_size - 1) / block_size, m, [&](std::size_t b, auto&& emit) {
+				for (auto i = b * block_size; i < std::min(m, (b + 1) * block_size); ++i) {
+					// Endpoints are numbered `2i` for the tail and `2i + 1` for the head of edge `i`, and each head copies an endpoint numbered below it
+					auto j = 2 * i + 1;
+					while (j % 2)
+						j = impl::_splitmix64::stream(seed, j).below(j);
+					emit(i / k, j / 2 / k);
+				}
+			});
+		}
+
+		// Inserts `n` vertices at uniformly random points in the unit square, with an edge from each vertex to each later one within distance `radius` of it.  Points are bucketed in a grid of cells at least `radius` wide, and no more than the square root of `n` to a side, so only neighboring cells are searched.
+		// @return The position of each new vertex.
+		template <class Impl, class Random>
+		auto generate_random_geometric(Graph<Impl>& g, std::size_t n, double radius, Random& r) {
+			using size_type = std::size_t;
+			impl::check_precondition(radius >= 0, "radius must be non-negative");
+			auto verts = impl::_generate_verts(g, n);
+			const auto seed = impl::_generator_seed(r);
+			std::vector<std::array<double, 2>> points(n);
+			#pragma omp parallel for
+			for (size_type i = 0; i < n; ++i) {
+				auto stream = impl::_splitmix64::stream(seed, i);
+				points[i] = {stream.uniform(), stream.uniform()};
+			}
+			auto position = g.vert_map(std::array<double, 2>{});
+			for (size_type i = 0; i < n; ++i)
+				position[verts[i]] = points[i];
+			if (n < 2)
+				return position;
+			// A radius of zero still only joins coincident points, so it gets the finest grid rather than a single cell
+			const double finest = std::ceil(std::sqrt(static_cast<double>(n)));
+			const auto cells = static_cast<size_type>(std::clamp(radius > 0 ? std::floor(1 / radius) : finest, 1.0, finest));
+			auto cell = [&](double x) {
+				return std::min(static_cast<size_type>(x * cells), cells - 1);
+			};
+			std::vector<size_type> keys(n);
+			for (size_type i = 0; i < n; ++i)
+				keys[i] = cell(points[i][0]) * cells + cell(points[i][1]);
+			auto [offsets, members] = impl::_counting_sort(keys, cells * cells);
+			const double radius2 = radius * radius;
+			impl::_generate_edges(g, verts, n, std::nullopt, [&](size_type u, auto&& emit) {
+				const size_type cx = cell(points[u][0]), cy = cell(points[u][1]);
+				for (auto x = cx ? cx - 1 : cx; x <= std::min(cx + 1, cells - 1); ++x) {
+					for (auto y = cy ? cy - 1 : cy; y <= std::min(cy + 1, cells - 1); ++y) {
+						auto k = x * cells + y;
+						for (auto i = offsets[k]; i < offsets[k + 1]; ++i) {
+							auto v = members[i];
+							auto dx = points[u][0] - points[v][0], dy = points[u][1] - points[v][1];
+							if (v > u && dx * dx + dy * dy <= radius2)
+								emit(u, v);
+						}
+					}
+				}
+			});
+			return position;
+		}
+	}
+}
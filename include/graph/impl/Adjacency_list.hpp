@@ -12,6 +12,7 @@
 #include "tracker.hpp"
 #include "construct_fn.hpp"
 #include "exceptions.hpp"
+#include "sampling_index.hpp"
 #include "Edge_list.hpp"
 
 // Ideally, there would be a good way to get an iterator from const_iterator and a mutable container (better than a zero-length erase).  Since there is not, we have to make our container mutable so we can get iterators to it in const contexts.
@@ -100,7 +101,9 @@ namespace graph {
 					return e.second._it->second;
 				}
 				auto insert_vert() {
-					return Vert{_vlist.emplace_hint(_vlist.end(), _vlast++, _elist_type{})};
+					Vert v{_vlist.emplace_hint(_vlist.end(), _vlast++, _elist_type{})};
+					_vsample.insert(v);
+					return v;
 				}
 				// precondition: `v` must be unreachable from other vertices
 				void erase_vert(const Vert& v) {
@@ -112,18 +115,24 @@ namespace graph {
 					_esize -= _degree(v);
 					for (auto& m : _vmap_tracker.trackees())
 						m._erase(v);
+					for (auto e : _vert_edges(v))
+						_esample.erase(e);
+					_vsample.erase(v);
 					_vlist.erase(v._it);
 				}
 				auto _insert_edge(Vert k, Vert v) {
 					++_esize;
 					auto kit = GRAPH_V1_ADJACENCY_LIST_REMOVE_CONST(k._it);
 					auto&& es = kit->second;
-					return Edge{std::move(k),
+					Edge e{std::move(k),
 						es.emplace_hint(es.end(), _elast++, _vert_type{std::move(v)})};
+					_esample.insert(e);
+					return e;
 				}
 				auto erase_edge(const Edge& e) {
 					for (auto& m : _emap_tracker.trackees())
 						m._erase(e);
+					_esample.erase(e);
 					Vert k = _edge_key(e);
 					auto kit = GRAPH_V1_ADJACENCY_LIST_REMOVE_CONST(k._it);
 					kit->second.erase(e.second._it);
@@ -133,9 +142,19 @@ namespace graph {
 					for (auto& m : _emap_tracker.trackees())
 						m._clear();
 					_vlist.clear();
+					_vsample.clear();
+					_esample.clear();
 					_vlast = 0;
 					_esize = _elast = 0;
 				}
+				template <class Random>
+				Vert random_vert(Random& r) const {
+					return _vsample.sample(r);
+				}
+				template <class Random>
+				Edge random_edge(Random& r) const {
+					return _esample.sample(r);
+				}
 
 				using _vmap_tracker_type = tracker<erasable_base<Vert>>;
 
@@ -241,6 +260,14 @@ namespace graph {
 				}
 			private:
 				GRAPH_V1_ADJACENCY_LIST_VLIST_MUTABLE _vlist_type _vlist;
+				// Edges are keyed by their own iterators, which are unique across vertices
+				struct _edge_sample_key {
+					const _edge_type& operator()(const Edge& e) const noexcept {
+						return e.second;
+					}
+				};
+				sampling_index<Vert> _vsample;
+				sampling_index<Edge, _edge_sample_key> _esample;
 				Order _vlast = 0;
 				Size _esize = 0, _elast = 0;
 				_vmap_tracker_type _vmap_tracker;
@@ -7,6 +7,7 @@
 
 #include "Vert_list.hpp"
 #include "unordered_set.hpp"
+#include "sampling_index.hpp"
 #include "map_iterator_wrapper.hpp"
 #include "tracker.hpp"
 #include "construct_fn.hpp"
@@ -40,8 +41,10 @@ namespace graph {
 					return e._it->second.second;
 				}
 				auto insert_edge(Vert s, Vert t) {
-					return Edge{_elist.try_emplace(_elist.end(),
+					Edge e{_elist.try_emplace(_elist.end(),
 						_elast++, std::move(s), std::move(t))};
+					_esample.insert(e);
+					return e;
 				}
 				// precondition: vertex must be disconnected
 				void erase_vert(const Vert& v) {
@@ -54,15 +57,21 @@ namespace graph {
 				void erase_edge(const Edge& e) {
 					for (auto& m : _emap_tracker.trackees())
 						m._erase(e);
+					_esample.erase(e);
 					_elist.erase(e._it);
 				}
 				void clear() {
 					for (auto& m : _emap_tracker.trackees())
 						m._clear();
 					_elist.clear();
+					_esample.clear();
 					_elast = 0;
 					_base_type::clear();
 				}
+				template <class Random>
+				Edge random_edge(Random& r) const {
+					return _esample.sample(r);
+				}
 				using _emap_tracker_type = tracker<erasable_base<Edge>>;
 				template <class T>
 				using Edge_map = tracked<persistent_map_iterator_map<Edge, T>, _emap_tracker_type>;
@@ -86,6 +95,7 @@ namespace graph {
 				}
 			private:
 				_elist_type _elist;
+				sampling_index<Edge> _esample;
 				Size _elast = 0;
 				_emap_tracker_type _emap_tracker;
 			};
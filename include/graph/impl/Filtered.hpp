@@ -0,0 +1,180 @@
+#pragma once
+
+#include <type_traits>
+#include <functional>
+#include <optional>
+
+#include <range/v3/view/filter.hpp>
+#include <range/v3/distance.hpp>
+
+#include "traits.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			// Mask which keeps every vertex or edge.
+			struct keep_all_fn {
+				template <class K>
+				constexpr bool operator()(const K&) const noexcept {
+					return true;
+				}
+			};
+
+			template <class Mask, class K, class = void>
+			struct _is_set_mask : std::false_type {};
+			template <class Mask, class K>
+			struct _is_set_mask<Mask, K,
+				std::void_t<decltype(std::declval<const Mask&>().contains(std::declval<const K&>()))>> : std::true_type {};
+
+			// A mask is either a set, which keeps its members, or a predicate, such as a map to `bool`.
+			template <class Mask, class K>
+			bool _keeps(const Mask& mask, const K& k) {
+				if constexpr (_is_set_mask<Mask, K>{})
+					return mask.contains(k);
+				else
+					return static_cast<bool>(mask(k));
+			}
+			template <class Mask, class K>
+			bool _keeps(const std::reference_wrapper<Mask>& mask, const K& k) {
+				return _keeps(mask.get(), k);
+			}
+
+			// As range adaptors do, a mask given as an lvalue is held by reference, and one given as an rvalue by value.
+			template <class Mask>
+			using _held_mask_t = std::conditional_t<std::is_lvalue_reference_v<Mask>,
+				std::reference_wrapper<const std::remove_reference_t<Mask>>, std::decay_t<Mask>>;
+
+			// View of the vertices kept by one mask and the edges between them kept by another.
+			template <class Impl, class Vert_mask, class Edge_mask>
+			struct Filtered {
+				Filtered() = default;
+				Filtered(const Filtered&) = default;
+				Filtered(Filtered&&) = default;
+				template <class VM, class EM>
+				Filtered(Impl&& impl, VM&& vert_mask, EM&& edge_mask) :
+					_impl(std::forward<Impl>(impl)), _vert_mask(std::forward<VM>(vert_mask)), _edge_mask(std::forward<EM>(edge_mask)) {
+				}
+				template <class V>
+				bool _keeps_vert(const V& v) const {
+					return _keeps(*_vert_mask, v);
+				}
+				template <class E>
+				bool _keeps_edge(const E& e) const {
+					using Edges = traits::Edges<Impl>;
+					return _keeps(*_edge_mask, e) &&
+						_keeps_vert(Edges::tail(_impl, e)) && _keeps_vert(Edges::head(_impl, e));
+				}
+				Impl _impl;
+				// Optional only so that the view is default constructible, as the virtual base of a bidirectional graph must be, even when a mask is a lambda
+				std::optional<Vert_mask> _vert_mask;
+				std::optional<Edge_mask> _edge_mask;
+			};
+			namespace traits {
+				// Counting is linear, since masks may change during the lifetime of the view.
+				template <class G, class VM, class EM>
+				struct Verts<Filtered<G, VM, EM>> : Verts<G> {
+					using F = Filtered<G, VM, EM>;
+					using _base_type = Verts<G>;
+					using size_type = typename _base_type::size_type;
+					static decltype(auto) range(const F& f) {
+						return _base_type::range(f._impl) |
+							ranges::view::filter([&f](const auto& v) { return f._keeps_vert(v); });
+					}
+					static size_type size(const F& f) {
+						return static_cast<size_type>(ranges::distance(range(f)));
+					}
+					static decltype(auto) null(const F& f) {
+						return _base_type::null(f._impl);
+					}
+					static decltype(auto) set(const F& f) {
+						return _base_type::set(f._impl);
+					}
+					static decltype(auto) ephemeral_set(const F& f) {
+						return _base_type::ephemeral_set(f._impl);
+					}
+					template <class T>
+					static decltype(auto) map(const F& f, T default_) {
+						return _base_type::map(f._impl, std::move(default_));
+					}
+					template <class T>
+					static decltype(auto) ephemeral_map(const F& f, T default_) {
+						return _base_type::ephemeral_map(f._impl, std::move(default_));
+					}
+				};
+				template <class G, class VM, class EM>
+				struct Edges<Filtered<G, VM, EM>> : Edges<G> {
+					using F = Filtered<G, VM, EM>;
+					using _base_type = Edges<G>;
+					using value_type = typename _base_type::value_type;
+					using size_type = typename _base_type::size_type;
+					static decltype(auto) range(const F& f) {
+						return _base_type::range(f._impl) |
+							ranges::view::filter([&f](const auto& e) { return f._keeps_edge(e); });
+					}
+					static size_type size(const F& f) {
+						return static_cast<size_type>(ranges::distance(range(f)));
+					}
+					static decltype(auto) null(const F& f) {
+						return _base_type::null(f._impl);
+					}
+					static decltype(auto) tail(const F& f, const value_type& e) {
+						return _base_type::tail(f._impl, e);
+					}
+					static decltype(auto) head(const F& f, const value_type& e) {
+						return _base_type::head(f._impl, e);
+					}
+					static decltype(auto) set(const F& f) {
+						return _base_type::set(f._impl);
+					}
+					static decltype(auto) ephemeral_set(const F& f) {
+						return _base_type::ephemeral_set(f._impl);
+					}
+					template <class T>
+					static decltype(auto) map(const F& f, T default_) {
+						return _base_type::map(f._impl, std::move(default_));
+					}
+					template <class T>
+					static decltype(auto) ephemeral_map(const F& f, T default_) {
+						return _base_type::ephemeral_map(f._impl, std::move(default_));
+					}
+				};
+				template <class G, class VM, class EM>
+				struct Out_edges<Filtered<G, VM, EM>,
+					std::enable_if_t<traits::has_out_edges<G>>> :
+					Out_edges<G> {
+					using F = Filtered<G, VM, EM>;
+					using _base_type = Out_edges<G>;
+					using key_type = typename _base_type::key_type;
+					using size_type = typename _base_type::size_type;
+					static decltype(auto) range(const F& f, const key_type& v) {
+						return _base_type::range(f._impl, v) |
+							ranges::view::filter([&f](const auto& e) {
+								return _keeps(*f._edge_mask, e) && f._keeps_vert(Edges<G>::head(f._impl, e));
+							});
+					}
+					static size_type size(const F& f, const key_type& v) {
+						return static_cast<size_type>(ranges::distance(range(f, v)));
+					}
+				};
+				template <class G, class VM, class EM>
+				struct In_edges<Filtered<G, VM, EM>,
+					std::enable_if_t<traits::has_in_edges<G>>> :
+					In_edges<G> {
+					using F = Filtered<G, VM, EM>;
+					using _base_type = In_edges<G>;
+					using key_type = typename _base_type::key_type;
+					using size_type = typename _base_type::size_type;
+					static decltype(auto) range(const F& f, const key_type& v) {
+						return _base_type::range(f._impl, v) |
+							ranges::view::filter([&f](const auto& e) {
+								return _keeps(*f._edge_mask, e) && f._keeps_vert(Edges<G>::tail(f._impl, e));
+							});
+					}
+					static size_type size(const F& f, const key_type& v) {
+						return static_cast<size_type>(ranges::distance(range(f, v)));
+					}
+				};
+			}
+		}
+	}
+}
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <functional>
+#include <memory>
+
+#include <range/v3/iterator_range.hpp>
+
+#include "traits.hpp"
+#include "exceptions.hpp"
+#include "omp.hpp"
+#include "compact_adjacency.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			/* Frozen index over a forest of a graph, with the children of each vertex in compressed sparse rows, pre-order and post-order, and parallel aggregation over subtrees and root paths.  Instances should be constructed by calling <forest_index> on a subforest or subtree.
+			 *
+			 * Aggregation proceeds one level of depth at a time, in parallel within each level, unless the levels are too narrow to be worth a parallel region each, in which case it walks the pre-order serially.  As with any ephemeral structure, it is undefined behavior to modify the graph during its lifetime, and the index does not follow later changes to the forest.
+			 */
+			template <class G>
+			class Forest_index {
+				using Verts = traits::Verts<G>;
+				using size_type = std::size_t;
+			public:
+				using Vert = typename Verts::value_type;
+				template <class T>
+				using Vert_map = typename Verts::template ephemeral_map_type<T>;
+
+				// Indexes the forest in which `parent(v)` is the parent of `v`, or the null vertex for a root.
+				template <class Parent>
+				Forest_index(const G& g, const Parent& parent) :
+					_g(g), _index(g), _null(Verts::null(g)) {
+					const size_type n = _index.size(), none = n;
+					_parent.assign(n, none);
+					std::vector<size_type> keys(n);
+					for (size_type u = 0; u < n; ++u) {
+						auto p = parent(_index[u]);
+						if (p != _null)
+							_parent[u] = _index(p);
+						keys[u] = _parent[u] == none ? n : _parent[u];
+					}
+					// Children grouped by parent, with roots grouped last
+					auto [offsets, children] = _counting_sort(keys, n + 1);
+					_offsets = std::move(offsets);
+					_children = std::move(children);
+					_child_verts.reserve(n);
+					for (auto c : _children)
+						_child_verts.push_back(_index[c]);
+
+					_pre.assign(n, none);
+					_order.reserve(n);
+					_post_order.reserve(n);
+					_depth.assign(n, 0);
+					_root.assign(n, none);
+					_subtree_size.assign(n, 1);
+					// Each frame is a vertex and the position of its next child
+					std::vector<std::pair<size_type, size_type>> calls;
+					for (auto i = _offsets[n]; i < _offsets[n + 1]; ++i) {
+						auto r = _children[i];
+						_root[r] = r;
+						_pre[r] = _order.size();
+						_order.push_back(r);
+						calls.emplace_back(r, _offsets[r]);
+						while (!calls.empty()) {
+							auto [u, j] = calls.back();
+							if (j < _offsets[u + 1]) {
+								++calls.back().second;
+								auto c = _children[j];
+								_root[c] = _root[u];
+								_depth[c] = _depth[u] + 1;
+								_pre[c] = _order.size();
+								_order.push_back(c);
+								calls.emplace_back(c, _offsets[c]);
+								continue;
+							}
+							calls.pop_back();
+							_post_order.push_back(_index[u]);
+							if (_parent[u] != none)
+								_subtree_size[_parent[u]] += _subtree_size[u];
+						}
+					}
+					check_precondition(_order.size() == n, "forest must be acyclic");
+					_pre_order.reserve(n);
+					for (auto u : _order)
+						_pre_order.push_back(_index[u]);
+
+					// Vertices grouped by depth, for level-synchronous aggregation
+					std::vector<size_type> depth_keys(_depth);
+					size_type height = 0;
+					for (auto d : _depth)
+						height = std::max(height, d + 1);
+					std::tie(_level_offsets, _levels) = _counting_sort(depth_keys, height);
+				}
+
+				// @return The parent of `v`, or the null vertex if it is a root.
+				Vert parent(const Vert& v) const {
+					auto p = _parent[_index(v)];
+					return p == _index.size() ? _null : _index[p];
+				}
+				// @return The children of `v`.
+				auto children(const Vert& v) const {
+					auto u = _index(v);
+					return ranges::iterator_range<const Vert*>(_child_verts.data() + _offsets[u], _child_verts.data() + _offsets[u + 1]);
+				}
+				// @return The roots of the forest.
+				auto roots() const {
+					const auto n = _index.size();
+					return ranges::iterator_range<const Vert*>(_child_verts.data() + _offsets[n], _child_verts.data() + _offsets[n + 1]);
+				}
+				// @return Every vertex, each before its children.
+				const std::vector<Vert>& pre_order() const {
+					return _pre_order;
+				}
+				// @return Every vertex, each after its children.
+				const std::vector<Vert>& post_order() const {
+					return _post_order;
+				}
+				// @return The number of edges between `v` and its root.
+				size_type depth(const Vert& v) const {
+					return _depth[_index(v)];
+				}
+				// @return The root of the tree containing `v`.
+				Vert root(const Vert& v) const {
+					return _index[_root[_index(v)]];
+				}
+				// @return The number of vertices in the subtree rooted at `v`, including `v`.
+				size_type subtree_size(const Vert& v) const {
+					return _subtree_size[_index(v)];
+				}
+				// @return Whether `u` is `v` or one of its ancestors.
+				bool is_ancestor(const Vert& u, const Vert& v) const {
+					auto i = _index(u), j = _index(v);
+					return _pre[i] <= _pre[j] && _pre[j] < _pre[i] + _subtree_size[i];
+				}
+
+				// Combines `value(v)` over each subtree, bottom-up in parallel.
+				// @return A map from each vertex `v` to `combine` applied to `value(v)` and the results of its children in turn.
+				template <class Value, class Combine = std::plus<>>
+				auto subtree_aggregate(const Value& value, const Combine& combine = {}) const {
+					using T = std::decay_t<std::invoke_result_t<const Value&, Vert>>;
+					// Not a std::vector, which would pack bools into words shared between threads
+					auto result = std::make_unique<T[]>(_index.size());
+					auto aggregate = [&](size_type u) {
+						T x = value(_index[u]);
+						for (auto j = _offsets[u]; j < _offsets[u + 1]; ++j)
+							x = combine(std::move(x), result[_children[j]]);
+						result[u] = std::move(x);
+					};
+					if (_is_narrow()) {
+						// Children follow their parents in pre-order
+						for (auto i = _order.size(); i-- > 0;)
+							aggregate(_order[i]);
+					} else {
+						for (auto level = _height(); level-- > 0;) {
+							auto begin = _level_offsets[level], end = _level_offsets[level + 1];
+							#pragma omp parallel for schedule(dynamic, _grain) if(end - begin > _grain)
+							for (auto i = begin; i < end; ++i)
+								aggregate(_levels[i]);
+						}
+					}
+					return _to_map(std::move(result));
+				}
+				// Combines `value(v)` along each path from a root, top-down in parallel.
+				// @return A map from each vertex `v` to `combine` applied to the result of its parent, if any, and `value(v)`.
+				template <class Value, class Combine = std::plus<>>
+				auto root_path_aggregate(const Value& value, const Combine& combine = {}) const {
+					using T = std::decay_t<std::invoke_result_t<const Value&, Vert>>;
+					// Not a std::vector, which would pack bools into words shared between threads
+					auto result = std::make_unique<T[]>(_index.size());
+					const auto none = _index.size();
+					auto aggregate = [&](size_type u) {
+						result[u] = _parent[u] != none ? combine(result[_parent[u]], value(_index[u])) : T(value(_index[u]));
+					};
+					if (_is_narrow()) {
+						for (auto u : _order)
+							aggregate(u);
+					} else {
+						for (size_type level = 0; level < _height(); ++level) {
+							auto begin = _level_offsets[level], end = _level_offsets[level + 1];
+							#pragma omp parallel for schedule(dynamic, _grain) if(end - begin > _grain)
+							for (auto i = begin; i < end; ++i)
+								aggregate(_levels[i]);
+						}
+					}
+					return _to_map(std::move(result));
+				}
+				// @return A map from each vertex to the number of vertices in its subtree.
+				auto subtree_sizes() const {
+					return _to_map(_subtree_size);
+				}
+
+			protected:
+				// Levels narrower than this on average are aggregated serially
+				static constexpr size_type _grain = 1024;
+
+				size_type _height() const {
+					return _level_offsets.size() - 1;
+				}
+				bool _is_narrow() const {
+					return _index.size() < _grain * _height();
+				}
+				template <class Values>
+				auto _to_map(Values values) const {
+					using T = std::decay_t<decltype(values[0])>;
+					Vert_map<T> result = Verts::ephemeral_map(_g.get(), T{});
+					for (size_type u = 0; u < _index.size(); ++u)
+						result[_index[u]] = std::move(values[u]);
+					return result;
+				}
+
+				std::reference_wrapper<const G> _g;
+				compact_index<G> _index;
+				Vert _null;
+				std::vector<size_type> _parent, _offsets, _children, _pre, _order, _depth, _root, _subtree_size, _level_offsets, _levels;
+				std::vector<Vert> _child_verts, _pre_order, _post_order;
+			};
+		}
+	}
+}
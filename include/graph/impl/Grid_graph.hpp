@@ -0,0 +1,245 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+#include <range/v3/view/iota.hpp>
+#include <range/v3/view/filter.hpp>
+#include <range/v3/view/join.hpp>
+#include <range/v3/view/transform.hpp>
+
+#include "construct_fn.hpp"
+#include "exceptions.hpp"
+#include "integral_wrapper.hpp"
+#include "contiguous_key_map.hpp"
+#include "unordered_set.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		// Cells which <Grid_graph> considers adjacent.
+		enum class Grid_neighborhood {
+			// Cells sharing a face, 4 in two dimensions and 6 in three
+			von_neumann,
+			// Cells sharing a face, edge, or corner, 8 in two dimensions and 26 in three
+			moore,
+		};
+
+		namespace impl {
+			struct grid_edge_tag;
+			// Edges of a grid are keyed by their tail and direction, so unlike other integral handles, their keys are not bounded by the number of edges.
+			template <class Size>
+			struct grid_edge : integral_wrapper<Size, grid_edge_tag> {
+				using integral_wrapper<Size, grid_edge_tag>::integral_wrapper;
+			};
+
+			template <std::size_t D, class Order_ = std::size_t, class Size_ = std::size_t>
+			struct Grid_graph {
+				static_assert(D > 0);
+				using Order = Order_;
+				using Size = Size_;
+				using Vert = integral_wrapper<Order, struct vert_tag>;
+				using Edge = grid_edge<Size>;
+				using Coordinates = std::array<Order, D>;
+				using Out_degree = std::size_t;
+				using In_degree = std::size_t;
+
+				Grid_graph() = default;
+				// Constructs the grid with `extent[i]` cells along each axis `i`, in which the cells `v` with `blocked[v.key()]`, if any, are obstacles without edges.
+				explicit Grid_graph(Coordinates extent, Grid_neighborhood neighborhood = Grid_neighborhood::von_neumann, std::vector<bool> blocked = {}) :
+					_extent(extent), _order(1), _blocked(std::move(blocked)) {
+					for (auto i = D; i-- > 0;) {
+						_stride[i] = _order;
+						_order *= _extent[i];
+					}
+					check_precondition(_blocked.empty() || _blocked.size() == _order, "obstacle mask must cover the grid");
+					// Every offset in {-1, 0, 1}^D except zero, keeping only those along one axis for the von Neumann neighborhood
+					std::array<int, D> delta;
+					for (std::size_t code = 0; code < _power(3); ++code) {
+						std::size_t axes = 0;
+						for (std::size_t i = 0, c = code; i < D; ++i, c /= 3)
+							axes += (delta[i] = static_cast<int>(c % 3) - 1) != 0;
+						if (axes && (neighborhood == Grid_neighborhood::moore || axes == 1))
+							_deltas.push_back(delta);
+					}
+					for (const auto& d : _deltas) {
+						std::ptrdiff_t offset = 0;
+						for (std::size_t i = 0; i < D; ++i)
+							offset += d[i] * static_cast<std::ptrdiff_t>(_stride[i]);
+						_offsets.push_back(offset);
+					}
+					std::int64_t size = 0;
+					#pragma omp parallel for reduction(+:size)
+					for (std::int64_t k = 0; k < static_cast<std::int64_t>(_order); ++k)
+						size += out_degree(Vert(static_cast<Order>(k)));
+					_size = static_cast<Size>(size);
+				}
+
+				auto verts() const noexcept {
+					return ranges::view::iota(Order{}, order()) |
+						ranges::view::transform(construct<Vert>);
+				}
+				auto null_vert() const noexcept {
+					return Vert{};
+				}
+				auto order() const noexcept {
+					return _order;
+				}
+				auto edges() const {
+					return verts() |
+						ranges::view::transform([this](const Vert& v) { return out_edges(v); }) |
+						ranges::view::join;
+				}
+				auto null_edge() const noexcept {
+					return Edge{};
+				}
+				auto size() const noexcept {
+					return _size;
+				}
+				auto tail(const Edge& e) const {
+					return Vert(static_cast<Order>(e.key() / _deltas.size()));
+				}
+				auto head(const Edge& e) const {
+					auto d = e.key() % _deltas.size();
+					return Vert(static_cast<Order>(static_cast<std::ptrdiff_t>(e.key() / _deltas.size()) + _offsets[d]));
+				}
+
+				auto out_edges(const Vert& v) const {
+					return _directions() |
+						ranges::view::filter([this, v](std::size_t d) { return _step(v, d, 1); }) |
+						ranges::view::transform([this, v](std::size_t d) { return _edge(v.key(), d); });
+				}
+				Out_degree out_degree(const Vert& v) const {
+					Out_degree degree = 0;
+					for (std::size_t d = 0; d < _deltas.size(); ++d)
+						degree += _step(v, d, 1);
+					return degree;
+				}
+				// The grid is symmetric, so each in-edge is the out-edge in the same direction from the opposite neighbor.
+				auto in_edges(const Vert& v) const {
+					return _directions() |
+						ranges::view::filter([this, v](std::size_t d) { return _step(v, d, -1); }) |
+						ranges::view::transform([this, v](std::size_t d) { return _edge(static_cast<std::size_t>(static_cast<std::ptrdiff_t>(v.key()) - _offsets[d]), d); });
+				}
+				In_degree in_degree(const Vert& v) const {
+					In_degree degree = 0;
+					for (std::size_t d = 0; d < _deltas.size(); ++d)
+						degree += _step(v, d, -1);
+					return degree;
+				}
+
+				// @return The number of cells along each axis.
+				const Coordinates& extent() const noexcept {
+					return _extent;
+				}
+				// @return The cell at `x`, or the null vertex if it is outside the grid.
+				Vert vert(const Coordinates& x) const {
+					Order k = 0;
+					for (std::size_t i = 0; i < D; ++i) {
+						if (!(x[i] < _extent[i]))
+							return null_vert();
+						k += x[i] * _stride[i];
+					}
+					return Vert(k);
+				}
+				// @return The coordinates of the cell `v`.
+				Coordinates coordinates(const Vert& v) const {
+					Coordinates x;
+					for (std::size_t i = 0; i < D; ++i)
+						x[i] = v.key() / _stride[i] % _extent[i];
+					return x;
+				}
+				bool is_blocked(const Vert& v) const {
+					return !_blocked.empty() && _blocked[v.key()];
+				}
+
+				template <class T>
+				using Vert_map = persistent_contiguous_key_map<Vert, T>;
+				template <class T>
+				auto vert_map(T default_) const {
+					return Vert_map<T>(order(), std::move(default_));
+				}
+				template <class T>
+				using Ephemeral_vert_map = ephemeral_contiguous_key_map<Vert, T>;
+				template <class T>
+				auto ephemeral_vert_map(T default_) const {
+					return Ephemeral_vert_map<T>(order(), std::move(default_));
+				}
+				using Vert_set = unordered_set<Vert>;
+				auto vert_set() const {
+					return Vert_set();
+				}
+				using Ephemeral_vert_set = ephemeral_contiguous_key_set<Vert>;
+				auto ephemeral_vert_set() const {
+					return Ephemeral_vert_set(order());
+				}
+
+				// Edge maps span every direction from every cell, including those without an edge.
+				template <class T>
+				using Edge_map = persistent_contiguous_key_map<Edge, T>;
+				template <class T>
+				auto edge_map(T default_) const {
+					return Edge_map<T>(_edge_bound(), std::move(default_));
+				}
+				template <class T>
+				using Ephemeral_edge_map = ephemeral_contiguous_key_map<Edge, T>;
+				template <class T>
+				auto ephemeral_edge_map(T default_) const {
+					return Ephemeral_edge_map<T>(_edge_bound(), std::move(default_));
+				}
+				using Edge_set = unordered_set<Edge>;
+				auto edge_set() const {
+					return Edge_set();
+				}
+				using Ephemeral_edge_set = ephemeral_contiguous_key_set<Edge>;
+				auto ephemeral_edge_set() const {
+					return Ephemeral_edge_set(_edge_bound());
+				}
+
+			private:
+				static std::size_t _power(std::size_t base) {
+					std::size_t result = 1;
+					for (std::size_t i = 0; i < D; ++i)
+						result *= base;
+					return result;
+				}
+				auto _directions() const {
+					return ranges::view::iota(std::size_t{0}, _deltas.size());
+				}
+				std::size_t _edge_bound() const {
+					return static_cast<std::size_t>(_order) * _deltas.size();
+				}
+				Edge _edge(std::size_t k, std::size_t d) const {
+					return Edge(static_cast<Size>(k * _deltas.size() + d));
+				}
+				// @return Whether `v` and its neighbor `sign * _deltas[d]` away are both open cells of the grid.
+				bool _step(const Vert& v, std::size_t d, int sign) const {
+					auto k = v.key();
+					for (std::size_t i = 0; i < D; ++i) {
+						auto x = k / _stride[i] % _extent[i];
+						auto dx = sign * _deltas[d][i];
+						if ((dx < 0 && x == 0) || (dx > 0 && x + 1 == _extent[i]))
+							return false;
+					}
+					return !is_blocked(v) && !is_blocked(Vert(static_cast<Order>(static_cast<std::ptrdiff_t>(k) + sign * _offsets[d])));
+				}
+
+				Coordinates _extent{};
+				std::array<Order, D> _stride{};
+				Order _order = 0;
+				Size _size = 0;
+				std::vector<std::array<int, D>> _deltas;
+				std::vector<std::ptrdiff_t> _offsets;
+				std::vector<bool> _blocked;
+			};
+		}
+	}
+}
+
+namespace std {
+	template <class Size>
+	struct hash<::graph::v1::impl::grid_edge<Size>> :
+		hash<::graph::v1::impl::integral_wrapper<Size, ::graph::v1::impl::grid_edge_tag>> {
+	};
+}
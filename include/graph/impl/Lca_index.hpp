@@ -0,0 +1,100 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "exceptions.hpp"
+#include "omp.hpp"
+#include "Forest_index.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			/* <Forest_index> which also answers lowest common ancestor and tree-path length queries in constant time.  Instances should be constructed by calling <lca_index> on a subforest or subtree.
+			 *
+			 * Following Bender and Farach-Colton, but over the pre-order rather than an Euler tour, the lowest common ancestor of distinct vertices `u` and `v`, with `u` first, is the parent of the shallowest vertex in the pre-order after `u` up to and including `v`.  A sparse table answers each such range minimum with two overlapping lookups.  As with any ephemeral structure, it is undefined behavior to modify the graph during its lifetime, and the index does not follow later changes to the forest.
+			 */
+			template <class G, class W>
+			class Lca_index : public Forest_index<G> {
+				using _base_type = Forest_index<G>;
+				using size_type = std::size_t;
+				using _base_type::_index;
+				using _base_type::_null;
+				using _base_type::_parent;
+				using _base_type::_pre;
+				using _base_type::_depth;
+				using _base_type::_root;
+			public:
+				using Vert = typename _base_type::Vert;
+
+				// Indexes the forest in which `parent(v)` is the parent of `v`, or the null vertex for a root, and `length(v)` is the length of the edge to it.
+				template <class Parent, class Length>
+				Lca_index(const G& g, const Parent& parent, const Length& length) :
+					_base_type(g, parent) {
+					const size_type n = _index.size();
+					_distance.assign(n, W{});
+					for (auto u : this->_order)
+						if (_parent[u] != n)
+							_distance[u] = _distance[_parent[u]] + W(length(_index[u]));
+					_log.assign(n + 1, 0);
+					for (size_type i = 2; i <= n; ++i)
+						_log[i] = _log[i / 2] + 1;
+					// Level `k` holds, for each position, the shallowest vertex among the `2^k` starting there
+					_table.emplace_back(this->_order);
+					for (size_type width = 1; 2 * width <= n; width *= 2) {
+						const auto& previous = _table.back();
+						std::vector<size_type> level(n - 2 * width + 1);
+						#pragma omp parallel for
+						for (size_type i = 0; i < level.size(); ++i)
+							level[i] = _shallower(previous[i], previous[i + width]);
+						_table.push_back(std::move(level));
+					}
+				}
+
+				// @return The total length of the edges between `v` and its root.
+				const W& root_distance(const Vert& v) const {
+					return _distance[_index(v)];
+				}
+				// @return The deepest common ancestor of `u` and `v`, or the null vertex if they are in different trees.
+				Vert lowest_common_ancestor(const Vert& u, const Vert& v) const {
+					auto a = _lca(_index(u), _index(v));
+					return a == _index.size() ? _null : _index[a];
+				}
+				// @return The number of edges on the path between `u` and `v`, which must be in the same tree.
+				size_type path_size(const Vert& u, const Vert& v) const {
+					auto i = _index(u), j = _index(v), a = _checked_lca(i, j);
+					return _depth[i] + _depth[j] - 2 * _depth[a];
+				}
+				// @return The total length of the edges on the path between `u` and `v`, which must be in the same tree.
+				W path_length(const Vert& u, const Vert& v) const {
+					auto i = _index(u), j = _index(v), a = _checked_lca(i, j);
+					return (_distance[i] - _distance[a]) + (_distance[j] - _distance[a]);
+				}
+
+			private:
+				size_type _shallower(size_type u, size_type v) const {
+					return _depth[v] < _depth[u] ? v : u;
+				}
+				size_type _lca(size_type u, size_type v) const {
+					if (u == v)
+						return u;
+					if (_root[u] != _root[v])
+						return _index.size();
+					auto l = std::min(_pre[u], _pre[v]) + 1, r = std::max(_pre[u], _pre[v]) + 1;
+					auto k = _log[r - l];
+					return _parent[_shallower(_table[k][l], _table[k][r - (size_type{1} << k)])];
+				}
+				size_type _checked_lca(size_type u, size_type v) const {
+					auto a = _lca(u, v);
+					check_precondition(a != _index.size(), "vertices must be in the same tree");
+					return a;
+				}
+
+				std::vector<size_type> _log;
+				std::vector<W> _distance;
+				std::vector<std::vector<size_type>> _table;
+			};
+		}
+	}
+}
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <vector>
+#include <memory>
 #include <functional>
+#include <mutex>
+#include <utility>
 #include <range/v3/view/all.hpp>
 #include <range/v3/to_container.hpp>
 
@@ -11,61 +14,186 @@
 namespace graph {
 	inline namespace v1 {
 		namespace impl {
+			// A path either owns its edges, or is a rope of shared segments, each of which either owns its edges or walks the parent edges of a subforest on demand.  Paths with lazy segments are concatenated without copying edges, and only gather their edges when asked.
 			template <class G>
 			struct Path {
 				using Verts = traits::Verts<G>;
 				using Edges = traits::Edges<G>;
 				using Vert = typename Verts::value_type;
 				using Edge = typename Edges::value_type;
+				using size_type = std::size_t;
 				using _container_type = std::vector<Edge>;
 				Path(const G& g, Vert source) :
-					_vert(std::move(source)) {
+					_source_vert(source), _target_vert(std::move(source)) {
 				}
 				explicit Path(const G& g) : Path(g, Verts::null(g)) {}
 				Path(const G& g, Vert source, _container_type edges) :
-					_edges(std::move(edges)),
-					_vert(std::move(source)) {
+					Path(g, std::move(source)) {
 #if GRAPH_CHECK_PRECONDITIONS
-					auto v = _vert;
-					for (const auto& e : _edges) {
-						check_precondition(Edges::tail(g, e) == v, "edges must form a path");
-						v = Edges::head(g, e);
+					for (const auto& e : edges) {
+						check_precondition(Edges::tail(g, e) == _target_vert, "edges must form a path");
+						_target_vert = Edges::head(g, e);
 					}
 #endif
+					if (edges.empty())
+						return;
+					_target_vert = Edges::head(g, edges.back());
+					_size = edges.size();
+					_edges = std::move(edges);
 				}
 				template <class Edges>
 				Path(const G& g, Vert source, Edges&& edges) :
-					Path(std::move(source),
+					Path(g, std::move(source),
 						ranges::view::all(std::forward<Edges>(edges)) |
 							ranges::to_<_container_type>) {
 				}
+
+				// Constructs the path which follows `step(v)`, the parent edge of `v` or the null edge, from `v` to its root, or its reverse.  Only the endpoints and length are found now, and `step` is called again each time the path is traversed, so whatever it refers to must outlive the path.
+				template <class Step>
+				static Path _walk(const G& g, Vert v, Step step, bool reversed) {
+					auto segment = std::make_shared<_segment>(g, v);
+					segment->reversed = reversed;
+					auto u = v;
+					for (auto e = step(u); e != Edges::null(g); e = step(u), ++segment->size) {
+#if GRAPH_CHECK_PRECONDITIONS
+						check_precondition(segment->size < Verts::size(g), "forest must be acyclic");
+#endif
+						u = reversed ? Edges::tail(g, e) : Edges::head(g, e);
+					}
+					Path result(g, reversed ? u : v);
+					result._target_vert = reversed ? v : u;
+					if ((result._size = segment->size)) {
+						segment->step = std::move(step);
+						result._rope = std::make_shared<_rope_type>();
+						result._rope->segments.push_back(std::move(segment));
+					}
+					return result;
+				}
+
+				// @return A view of the edges of the path, which a lazy path gathers on the first call.
 				auto edges() const {
-					return ranges::view::all(_edges);
+					if (!_rope)
+						return ranges::view::all(_edges);
+					std::call_once(_rope->gathered, [this] {
+						_rope->edges.reserve(_size);
+						_for_each([this](const Edge& e) { _rope->edges.push_back(e); });
+					});
+					return ranges::view::all(std::as_const(_rope->edges));
+				}
+				// @return The number of edges in the path.
+				size_type size() const {
+					return _size;
 				}
 				bool is_trivial_or_null() const {
-					return _edges.empty();
+					return _size == 0;
 				}
 				template <class Weight, class Combine = std::plus<>,
 					class D = std::decay_t<std::result_of_t<const Weight&(Edge)>>>
 				D total(const Weight& weight, const Combine& combine = {}, const D& zero = {}) const {
 					auto result = zero;
-					for (const auto& e : _edges)
-						result = combine(result, weight(e));
+					_for_each([&](const Edge& e) { result = combine(result, weight(e)); });
 					return result;
 				}
 				Vert _source(const G& g) const {
-					return _vert;
+					return _source_vert;
 				}
-				Vert _target(const G& g) const {
-					return _edges.empty() ? _vert : Edges::head(g, _edges.back());
+				Vert _target(const G&) const {
+					return _target_vert;
 				}
+				// Appends the edges of `other`, copying them if both paths own their edges, and otherwise sharing the segments of both in a new rope.
 				void _concatenate(const G& g, const Path& other) {
 					check_precondition(_target(g) == other._source(g), "paths must be concatenable");
-					_edges.insert(_edges.end(), other._edges.begin(), other._edges.end());
+					if (!other._size)
+						return;
+					if (!_rope && !other._rope) {
+						_edges.insert(_edges.end(), other._edges.begin(), other._edges.end());
+					} else {
+						// The rope may be shared with copies of this path, so it is replaced rather than extended
+						auto rope = std::make_shared<_rope_type>();
+						_append_segments(g, rope->segments, _rope, std::move(_edges));
+						_append_segments(g, rope->segments, other._rope, other._edges);
+						_edges.clear();
+						_rope = std::move(rope);
+					}
+					_target_vert = other._target_vert;
+					_size += other._size;
 				}
 			private:
+				struct _segment {
+					_segment(const G& g, Vert from) :
+						g(&g), from(std::move(from)) {
+					}
+					const G *g;
+					size_type size = 0;
+					// Owned edges, if there is no `step`
+					_container_type edges;
+					std::function<Edge(const Vert&)> step;
+					Vert from;
+					bool reversed = false;
+
+					template <class F>
+					void for_each(F& f) const {
+						if (!step) {
+							for (const auto& e : edges)
+								f(e);
+							return;
+						}
+						auto v = from;
+						if (!reversed) {
+							for (size_type i = 0; i < size; ++i) {
+								auto e = step(v);
+								v = Edges::head(*g, e);
+								f(e);
+							}
+							return;
+						}
+						// Parent edges are only found from the far end, so a reversed walk is buffered
+						_container_type buffer;
+						buffer.reserve(size);
+						for (size_type i = 0; i < size; ++i) {
+							buffer.push_back(step(v));
+							v = Edges::tail(*g, buffer.back());
+						}
+						for (auto i = buffer.size(); i-- > 0;)
+							f(buffer[i]);
+					}
+				};
+				using _segments_type = std::vector<std::shared_ptr<const _segment>>;
+				struct _rope_type {
+					_segments_type segments;
+					// The edges, once gathered by <edges>
+					std::once_flag gathered;
+					_container_type edges;
+				};
+
+				// Appends the segments of the path with `rope` or owned `edges` to `segments`, making a single segment owning its edges if it has no rope.
+				template <class Container>
+				static void _append_segments(const G& g, _segments_type& segments, const std::shared_ptr<_rope_type>& rope, Container&& edges) {
+					if (rope) {
+						segments.insert(segments.end(), rope->segments.begin(), rope->segments.end());
+					} else if (!edges.empty()) {
+						auto segment = std::make_shared<_segment>(g, Edges::tail(g, edges.front()));
+						segment->size = edges.size();
+						segment->edges = std::forward<Container>(edges);
+						segments.push_back(std::move(segment));
+					}
+				}
+				template <class F>
+				void _for_each(F&& f) const {
+					if (!_rope) {
+						for (const auto& e : _edges)
+							f(e);
+						return;
+					}
+					for (const auto& segment : _rope->segments)
+						segment->for_each(f);
+				}
+
+				// Owned edges, if there is no rope
 				_container_type _edges;
-				Vert _vert;
+				std::shared_ptr<_rope_type> _rope;
+				Vert _source_vert, _target_vert;
+				size_type _size = 0;
 			};
 		}
 	}
@@ -7,6 +7,8 @@
 #include <range/v3/view/single.hpp>
 
 #include "traits.hpp"
+#include "Forest_index.hpp"
+#include "Lca_index.hpp"
 
 namespace graph {
 	inline namespace v1 {
@@ -22,7 +24,7 @@ namespace graph {
 				using Edge = typename Edges::value_type;
 				using Size = typename Edges::size_type;
 				Subforest_base(const G& g) : _g(g),
-					_edges(_g.get().vert_map(_g.get().null_edge())) {
+					_edges(Verts::map(_g.get(), Edges::null(_g.get()))) {
 				}
 				auto verts() const {
 					return Verts::range(_g);
@@ -109,6 +111,22 @@ namespace graph {
 					return _edges(v) == null_edge();
 				}
 
+				// Freezes the forest into an index with the children of each vertex, pre-order and post-order, and parallel aggregation over subtrees.
+				auto forest_index() const {
+					return Forest_index<G>(_g, [this](const Vert& v) { return _parent_or_null(v); });
+				}
+				// Builds an index answering lowest common ancestor, depth and path size queries in constant time.
+				auto lca_index() const {
+					return lca_index([](const Edge&) { return std::size_t{1}; });
+				}
+				// Builds an index which also answers path length queries in constant time, for edge lengths `weight` which can be subtracted.
+				template <class Weight>
+				auto lca_index(const Weight& weight) const {
+					using W = std::decay_t<std::invoke_result_t<const Weight&, Edge>>;
+					return Lca_index<G, W>(_g, [this](const Vert& v) { return _parent_or_null(v); },
+						[&](const Vert& v) { return weight(_edges(v)); });
+				}
+
 			protected:
 				using _degree_type = int;
 				auto _key_edge_or_null(const Vert& v) const {
@@ -121,6 +139,10 @@ namespace graph {
 				_degree_type _key_degree(const Vert& v) const {
 					return (_edges(v) != null_edge()) ? 1 : 0;
 				}
+				Vert _parent_or_null(const Vert& v) const {
+					auto e = _edges(v);
+					return e == null_edge() ? null_vert() : traits::adjacency_cokey<Adjacency>(_g, e);
+				}
 				std::pair<Vert, std::vector<Edge>> _key_path(Vert v) const {
 					std::vector<Edge> path;
 					for (Edge e; (e = _edges(v)) != null_edge(); path.push_back(e)) {
@@ -132,6 +154,9 @@ namespace graph {
 					}
 					return std::make_pair(v, path);
 				}
+				Path<G> _lazy_key_path(const Vert& v, bool reversed) const {
+					return Path<G>::_walk(_g, v, [this](const Vert& u) { return _edges(u); }, reversed);
+				}
 
 			protected:
 				std::reference_wrapper<const G> _g;
@@ -161,6 +186,11 @@ namespace graph {
 					auto [r, edges] = this->_key_path(v);
 					return Path<G>(this->_g, v, std::move(edges));
 				}
+				// Like <path_to_root_from>, but only finds the endpoints and length now, and walks the tree each time the path is traversed.  As with any ephemeral structure, it is undefined behavior to modify the graph or this subforest during the lifetime of the path, and this subforest must outlive it.
+				auto lazy_path_to_root_from(const Vert& v) const& {
+					return this->_lazy_key_path(v, false);
+				}
+				auto lazy_path_to_root_from(const Vert& v) const&& = delete;
 			};
 			template <class G>
 			struct Subforest<traits::In, G> :
@@ -184,6 +214,11 @@ namespace graph {
 					std::reverse(edges.begin(), edges.end());
 					return Path<G>(this->_g, std::move(r), std::move(edges));
 				}
+				// Like <path_from_root_to>, but only finds the endpoints and length now, and walks the tree each time the path is traversed.  As with any ephemeral structure, it is undefined behavior to modify the graph or this subforest during the lifetime of the path, and this subforest must outlive it.
+				auto lazy_path_from_root_to(const Vert& v) const& {
+					return this->_lazy_key_path(v, true);
+				}
+				auto lazy_path_from_root_to(const Vert& v) const&& = delete;
 			};
 
 			// Subtrees
@@ -218,6 +253,11 @@ namespace graph {
 						return Path<G>(this->_g);
 					return Path<G>(this->_g, v, std::move(edges));
 				}
+				auto lazy_path_to_root_from(const Vert& v) const& {
+					auto path = this->_lazy_key_path(v, false);
+					return this->is_root(path._target(this->_g)) ? path : Path<G>(this->_g);
+				}
+				auto lazy_path_to_root_from(const Vert& v) const&& = delete;
 			};
 			template <class G>
 			struct Subtree<traits::In, G> : Subtree_base<traits::In, G> {
@@ -231,6 +271,11 @@ namespace graph {
 					std::reverse(edges.begin(), edges.end());
 					return Path<G>(this->_g, std::move(r), std::move(edges));
 				}
+				auto lazy_path_from_root_to(const Vert& v) const& {
+					auto path = this->_lazy_key_path(v, true);
+					return this->is_root(path._source(this->_g)) ? path : Path<G>(this->_g);
+				}
+				auto lazy_path_from_root_to(const Vert& v) const&& = delete;
 			};
 			namespace traits {
 				// TODO: This should specialize Verts and Edges to avoid typedef repetition above
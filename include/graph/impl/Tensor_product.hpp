@@ -10,6 +10,8 @@
 #include "construct_fn.hpp"
 #include "unordered_set.hpp"
 #include "unordered_key_map.hpp"
+#include "contiguous_key_map.hpp"
+#include "mixed_radix_key_map.hpp"
 
 // TODO: Move `tuple_wrapper` to its own file.
 namespace graph {
@@ -23,6 +25,7 @@ namespace graph {
 			struct tuple_wrapper {
 				using tuple_type = tuple_t<T...>;
 				tuple_type _tuple;
+				tuple_wrapper() = default;
 				explicit tuple_wrapper(tuple_type&& tuple) :
 					_tuple(std::forward<tuple_type>(tuple)) {}
 #define GRAPH_IMPL_TUPLE_WRAPPER_BINARY_OP(OP) \
@@ -95,6 +98,7 @@ namespace graph {
 				using Order = std::common_type_t<int, typename traits::Verts<G>::size_type...>;
 				using Edge = tuple_wrapper<typename traits::Edges<G>::value_type...>;
 				using Size = std::common_type_t<int, typename traits::Edges<G>::size_type...>;
+				Tensor_product() = default;
 				explicit Tensor_product(G&&... g) : _g(g...) {}
 				auto verts() const {
 					return ranges::tuple_apply(
@@ -145,13 +149,33 @@ namespace graph {
 						}));
 				}
 
+				// When every factor numbers its handles contiguously, so does the product, and its ephemeral maps and sets are dense rather than hashed.  Indices are fixed when an ephemeral map or set is created, which is why persistent maps and sets, which must survive changes to the factors, remain hashed.
+				static constexpr bool _dense_verts = (is_integral_wrapper_v<typename traits::Verts<G>::value_type> && ...);
+				static constexpr bool _dense_edges = (is_integral_wrapper_v<typename traits::Edges<G>::value_type> && ...);
+				using _vert_index_type = mixed_radix_index<Vert, typename traits::Verts<G>::value_type...>;
+				using _edge_index_type = mixed_radix_index<Edge, typename traits::Edges<G>::value_type...>;
+				_vert_index_type _vert_index() const {
+					return _vert_index_type(ranges::tuple_apply(
+						[](const auto&... g) { return std::array<std::size_t, sizeof...(G)>{ static_cast<std::size_t>(decltype(Verts(g))::size(g))... }; },
+						_g));
+				}
+				_edge_index_type _edge_index() const {
+					return _edge_index_type(ranges::tuple_apply(
+						[](const auto&... g) { return std::array<std::size_t, sizeof...(G)>{ static_cast<std::size_t>(decltype(Edges(g))::size(g))... }; },
+						_g));
+				}
+
 				using Vert_set = unordered_set<Vert>;
 				auto vert_set() const {
 					return Vert_set();
 				}
-				using Ephemeral_vert_set = Vert_set;
+				using Ephemeral_vert_set = std::conditional_t<_dense_verts,
+					mixed_radix_key_set<_vert_index_type>, unordered_set<Vert>>;
 				auto ephemeral_vert_set() const {
-					return vert_set();
+					if constexpr (_dense_verts)
+						return Ephemeral_vert_set(_vert_index());
+					else
+						return Ephemeral_vert_set();
 				}
 				template <class T>
 				using Vert_map = unordered_key_map<Vert, T>;
@@ -160,19 +184,27 @@ namespace graph {
 					return Vert_map<T>(std::move(default_));
 				}
 				template <class T>
-				using Ephemeral_vert_map = Vert_map<T>;
+				using Ephemeral_vert_map = std::conditional_t<_dense_verts,
+					mixed_radix_key_map<_vert_index_type, T, ephemeral_contiguous_key_map>, unordered_key_map<Vert, T>>;
 				template <class T>
 				auto ephemeral_vert_map(T default_) const {
-					return vert_map(std::move(default_));
+					if constexpr (_dense_verts)
+						return Ephemeral_vert_map<T>(_vert_index(), std::move(default_));
+					else
+						return Ephemeral_vert_map<T>(std::move(default_));
 				}
 
 				using Edge_set = unordered_set<Edge>;
 				auto edge_set() const {
 					return Edge_set();
 				}
-				using Ephemeral_edge_set = Edge_set;
+				using Ephemeral_edge_set = std::conditional_t<_dense_edges,
+					mixed_radix_key_set<_edge_index_type>, unordered_set<Edge>>;
 				auto ephemeral_edge_set() const {
-					return edge_set();
+					if constexpr (_dense_edges)
+						return Ephemeral_edge_set(_edge_index());
+					else
+						return Ephemeral_edge_set();
 				}
 				template <class T>
 				using Edge_map = unordered_key_map<Edge, T>;
@@ -181,14 +213,69 @@ namespace graph {
 					return Edge_map<T>(std::move(default_));
 				}
 				template <class T>
-				using Ephemeral_edge_map = Edge_map<T>;
+				using Ephemeral_edge_map = std::conditional_t<_dense_edges,
+					mixed_radix_key_map<_edge_index_type, T, ephemeral_contiguous_key_map>, unordered_key_map<Edge, T>>;
 				template <class T>
 				auto ephemeral_edge_map(T default_) const {
-					return edge_map(std::move(default_));
+					if constexpr (_dense_edges)
+						return Ephemeral_edge_map<T>(_edge_index(), std::move(default_));
+					else
+						return Ephemeral_edge_map<T>(std::move(default_));
 				}
 
-				// TODO: Add support for adjacencies when they are available in all constituent graphs.
+				const tuple_t<G...>& _factors() const {
+					return _g;
+				}
+
+				// The edges adjacent to a vertex are the products of the edges adjacent to its factors, so they are only available when every factor has them.
+				template <class Adjacency>
+				auto _adjacent_edges(const Vert& v) const {
+					return ranges::tuple_apply(
+						ranges::view::cartesian_product,
+						ranges::tuple_transform(_g, v._tuple,
+							[](const auto& g, const auto& v) {
+								return traits::Adjacent_edges<Adjacency, std::decay_t<decltype(g)>>::range(g, v);
+							}
+					)) | ranges::view::transform(construct<Edge>);
+				}
+				template <class Adjacency>
+				auto _adjacent_degree(const Vert& v) const {
+					return ranges::tuple_foldl(
+						ranges::tuple_transform(_g, v._tuple,
+							[](const auto& g, const auto& v) {
+								return traits::Adjacent_edges<Adjacency, std::decay_t<decltype(g)>>::size(g, v);
+							}
+					), Size{1}, std::multiplies{});
+				}
 			};
+			namespace traits {
+				template <class... G>
+				struct Out_edges<Tensor_product<G...>, std::enable_if_t<(has_out_edges<G> && ...)>> {
+					using P = Tensor_product<G...>;
+					using key_type = typename P::Vert;
+					using value_type = typename P::Edge;
+					using size_type = typename P::Size;
+					static decltype(auto) range(const P& p, const key_type& v) {
+						return p.template _adjacent_edges<Out>(v);
+					}
+					static size_type size(const P& p, const key_type& v) {
+						return p.template _adjacent_degree<Out>(v);
+					}
+				};
+				template <class... G>
+				struct In_edges<Tensor_product<G...>, std::enable_if_t<(has_in_edges<G> && ...)>> {
+					using P = Tensor_product<G...>;
+					using key_type = typename P::Vert;
+					using value_type = typename P::Edge;
+					using size_type = typename P::Size;
+					static decltype(auto) range(const P& p, const key_type& v) {
+						return p.template _adjacent_edges<In>(v);
+					}
+					static size_type size(const P& p, const key_type& v) {
+						return p.template _adjacent_degree<In>(v);
+					}
+				};
+			}
 		}
 	}
 }
\ No newline at end of file
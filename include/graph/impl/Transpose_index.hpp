@@ -0,0 +1,170 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include <range/v3/iterator_range.hpp>
+
+#include "traits.hpp"
+#include "omp.hpp"
+#include "compact_adjacency.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			/* Frozen index of the in-edges of a graph with out-edges, in compressed sparse columns.  The out-edges are gathered in parallel and grouped by head with a parallel counting sort, so the in-edges of each vertex are ordered by tail.
+			 *
+			 * As with any ephemeral structure, it is undefined behavior to modify the graph during its lifetime, and the index does not follow later changes to the graph.
+			 */
+			template <class G>
+			class Transpose_index {
+				using Edges = traits::Edges<G>;
+				using size_type = std::size_t;
+			public:
+				using Vert = typename traits::Verts<G>::value_type;
+				using Edge = typename Edges::value_type;
+
+				explicit Transpose_index(const G& g) :
+					_index(g) {
+					auto adj = _compact_adjacent_edges<traits::Out>(g, _index);
+					auto [offsets, order] = _counting_sort(adj.targets, _index.size());
+					_offsets = std::move(offsets);
+					_edges.assign(order.size(), Edges::null(g));
+					#pragma omp parallel for
+					for (size_type i = 0; i < order.size(); ++i)
+						_edges[i] = adj.edges[order[i]];
+				}
+
+				// @return The edges whose head is `v`.
+				auto in_edges(const Vert& v) const {
+					auto u = _index(v);
+					return ranges::iterator_range<const Edge*>(_edges.data() + _offsets[u], _edges.data() + _offsets[u + 1]);
+				}
+				size_type in_degree(const Vert& v) const {
+					auto u = _index(v);
+					return _offsets[u + 1] - _offsets[u];
+				}
+			private:
+				compact_index<G> _index;
+				std::vector<size_type> _offsets;
+				std::vector<Edge> _edges;
+			};
+
+			// View which adds in-edges to a graph with out-edges from a <Transpose_index>, built on first use and shared by every copy of the view.
+			template <class Impl>
+			struct With_transpose {
+				using _index_type = Transpose_index<std::remove_cv_t<std::remove_pointer_t<Impl>>>;
+				With_transpose() = default;
+				With_transpose(const With_transpose&) = default;
+				With_transpose(With_transpose&&) = default;
+				explicit With_transpose(Impl&& impl) :
+					_impl(std::forward<Impl>(impl)), _cache(std::make_shared<_cache_type>()) {
+				}
+				const _index_type& _transpose() const {
+					// Building once is safe from within parallel algorithms
+					std::call_once(_cache->once, [this] { _cache->index.emplace(*_impl); });
+					return *_cache->index;
+				}
+				Impl _impl;
+			private:
+				struct _cache_type {
+					std::once_flag once;
+					std::optional<_index_type> index;
+				};
+				std::shared_ptr<_cache_type> _cache;
+			};
+			namespace traits {
+				template <class G>
+				struct Verts<With_transpose<G>> : Verts<G> {
+					using W = With_transpose<G>;
+					using _base_type = Verts<G>;
+					static decltype(auto) range(const W& w) {
+						return _base_type::range(w._impl);
+					}
+					static decltype(auto) size(const W& w) {
+						return _base_type::size(w._impl);
+					}
+					static decltype(auto) null(const W& w) {
+						return _base_type::null(w._impl);
+					}
+					static decltype(auto) set(const W& w) {
+						return _base_type::set(w._impl);
+					}
+					static decltype(auto) ephemeral_set(const W& w) {
+						return _base_type::ephemeral_set(w._impl);
+					}
+					template <class T>
+					static decltype(auto) map(const W& w, T default_) {
+						return _base_type::map(w._impl, std::move(default_));
+					}
+					template <class T>
+					static decltype(auto) ephemeral_map(const W& w, T default_) {
+						return _base_type::ephemeral_map(w._impl, std::move(default_));
+					}
+				};
+				template <class G>
+				struct Edges<With_transpose<G>> : Edges<G> {
+					using W = With_transpose<G>;
+					using _base_type = Edges<G>;
+					using value_type = typename _base_type::value_type;
+					static decltype(auto) range(const W& w) {
+						return _base_type::range(w._impl);
+					}
+					static decltype(auto) size(const W& w) {
+						return _base_type::size(w._impl);
+					}
+					static decltype(auto) null(const W& w) {
+						return _base_type::null(w._impl);
+					}
+					static decltype(auto) tail(const W& w, const value_type& e) {
+						return _base_type::tail(w._impl, e);
+					}
+					static decltype(auto) head(const W& w, const value_type& e) {
+						return _base_type::head(w._impl, e);
+					}
+					static decltype(auto) set(const W& w) {
+						return _base_type::set(w._impl);
+					}
+					static decltype(auto) ephemeral_set(const W& w) {
+						return _base_type::ephemeral_set(w._impl);
+					}
+					template <class T>
+					static decltype(auto) map(const W& w, T default_) {
+						return _base_type::map(w._impl, std::move(default_));
+					}
+					template <class T>
+					static decltype(auto) ephemeral_map(const W& w, T default_) {
+						return _base_type::ephemeral_map(w._impl, std::move(default_));
+					}
+				};
+				template <class G>
+				struct Out_edges<With_transpose<G>> : Out_edges<G> {
+					using W = With_transpose<G>;
+					using _base_type = Out_edges<G>;
+					using key_type = typename _base_type::key_type;
+					static decltype(auto) range(const W& w, const key_type& v) {
+						return _base_type::range(w._impl, v);
+					}
+					static decltype(auto) size(const W& w, const key_type& v) {
+						return _base_type::size(w._impl, v);
+					}
+				};
+				template <class G>
+				struct In_edges<With_transpose<G>> {
+					using W = With_transpose<G>;
+					using key_type = typename Verts<G>::value_type;
+					using value_type = typename Edges<G>::value_type;
+					using size_type = std::size_t;
+					static decltype(auto) range(const W& w, const key_type& v) {
+						return w._transpose().in_edges(v);
+					}
+					static size_type size(const W& w, const key_type& v) {
+						return w._transpose().in_degree(v);
+					}
+				};
+			}
+		}
+	}
+}
@@ -8,6 +8,7 @@
 #include "tracker.hpp"
 #include "map_iterator_wrapper.hpp"
 #include "unordered_set.hpp"
+#include "sampling_index.hpp"
 
 namespace graph {
 	inline namespace v1 {
@@ -29,19 +30,27 @@ namespace graph {
 					return _vlist.size();
 				}
 				auto insert_vert() {
-					return Vert{_vlist.emplace_hint(_vlist.end(), _vlast++)};
+					Vert v{_vlist.emplace_hint(_vlist.end(), _vlast++)};
+					_vsample.insert(v);
+					return v;
 				}
 				void erase_vert(const Vert& v) {
 					for (auto& m : _vmap_tracker.trackees())
 						m._erase(v);
+					_vsample.erase(v);
 					_vlist.erase(v._it);
 				}
 				void clear() {
 					for (auto& m : _vmap_tracker.trackees())
 						m._clear();
 					_vlist.clear();
+					_vsample.clear();
 					_vlast = 0;
 				}
+				template <class Random>
+				Vert random_vert(Random& r) const {
+					return _vsample.sample(r);
+				}
 				using _vmap_tracker_type = tracker<erasable_base<Vert>>;
 				template <class T>
 				using Vert_map = tracked<persistent_map_iterator_map<Vert, T>, _vmap_tracker_type>;
@@ -66,6 +75,7 @@ namespace graph {
 				}
 			private:
 				_vlist_type _vlist;
+				sampling_index<Vert> _vsample;
 				Order _vlast = 0;
 				_vmap_tracker_type _vmap_tracker;
 			};
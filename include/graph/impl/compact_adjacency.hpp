@@ -0,0 +1,330 @@
+#pragma once
+
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <utility>
+#include <iterator>
+
+#include "traits.hpp"
+#include "omp.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			// Dense relabelling of the vertices of a graph onto `[0, order)`, so algorithms can use flat arrays regardless of the underlying vertex type.  As with any ephemeral structure, it is undefined behavior to modify the graph during its lifetime.
+			template <class G>
+			struct compact_index {
+				using Verts = traits::Verts<G>;
+				using Vert = typename Verts::value_type;
+				using size_type = std::size_t;
+				explicit compact_index(const G& g) :
+					_index(Verts::ephemeral_map(g, size_type{})) {
+					_verts.reserve(Verts::size(g));
+					for (auto v : Verts::range(g)) {
+						_index[v] = _verts.size();
+						_verts.push_back(std::move(v));
+					}
+				}
+				size_type size() const {
+					return _verts.size();
+				}
+				size_type operator()(const Vert& v) const {
+					return _index(v);
+				}
+				const Vert& operator[](size_type i) const {
+					return _verts[i];
+				}
+			private:
+				std::vector<Vert> _verts;
+				typename Verts::template ephemeral_map_type<size_type> _index;
+			};
+
+			// Compressed sparse row adjacency over the indices of a <compact_index>.
+			struct compact_adjacency {
+				using size_type = std::size_t;
+				std::vector<size_type> offsets{0};
+				std::vector<size_type> targets;
+				size_type order() const {
+					return offsets.size() - 1;
+				}
+				size_type size() const {
+					return targets.size();
+				}
+				size_type degree(size_type u) const {
+					return offsets[u + 1] - offsets[u];
+				}
+				const size_type *begin(size_type u) const {
+					return targets.data() + offsets[u];
+				}
+				const size_type *end(size_type u) const {
+					return targets.data() + offsets[u + 1];
+				}
+			};
+
+			// A <compact_adjacency> which also remembers the edge behind each entry.
+			template <class Edge>
+			struct compact_edge_adjacency : compact_adjacency {
+				std::vector<Edge> edges;
+			};
+
+			// A <compact_adjacency> with a weight on each entry.
+			template <class W>
+			struct compact_weighted_adjacency : compact_adjacency {
+				std::vector<W> weights;
+			};
+
+			// Dense per-thread accumulator over `[0, size)` which remembers the keys it has touched, so that clearing it costs no more than filling it.
+			template <class T>
+			struct sparse_accumulator {
+				using size_type = std::size_t;
+				std::vector<T> values;
+				std::vector<size_type> touched;
+				explicit sparse_accumulator(size_type size) :
+					values(size, T{}), _seen(size, false) {
+				}
+				void add(size_type k, const T& value) {
+					if (!_seen[k]) {
+						_seen[k] = true;
+						touched.push_back(k);
+					}
+					values[k] += value;
+				}
+				void clear() {
+					for (auto k : touched) {
+						values[k] = T{};
+						_seen[k] = false;
+					}
+					touched.clear();
+				}
+			private:
+				std::vector<char> _seen;
+			};
+
+			// Stable counting sort of the positions of `keys`, each of which must be less than `key_count`.
+			// @return The offset of the first position with each key (and a final sentinel), and the sorted positions.
+			inline std::pair<std::vector<std::size_t>, std::vector<std::size_t>>
+			_counting_sort(const std::vector<std::size_t>& keys, std::size_t key_count) {
+				using size_type = std::size_t;
+				const size_type m = keys.size();
+				std::vector<size_type> offsets(key_count + 1), order(m);
+				std::vector<std::vector<size_type>> counts;
+				#pragma omp parallel
+				{
+					const size_type t = omp_get_thread_num(), threads = omp_get_num_threads();
+					#pragma omp single
+					counts.assign(threads, std::vector<size_type>(key_count, 0));
+					// Each thread counts, then scatters, its own contiguous chunk, which keeps the sort stable
+					const size_type begin = m * t / threads, end = m * (t + 1) / threads;
+					auto& count = counts[t];
+					for (size_type i = begin; i < end; ++i)
+						++count[keys[i]];
+					#pragma omp barrier
+					#pragma omp single
+					{
+						size_type running = 0;
+						for (size_type k = 0; k < key_count; ++k) {
+							offsets[k] = running;
+							for (auto& c : counts)
+								running += std::exchange(c[k], running);
+						}
+						offsets[key_count] = running;
+					}
+					for (size_type i = begin; i < end; ++i)
+						order[count[keys[i]]++] = i;
+				}
+				return std::make_pair(std::move(offsets), std::move(order));
+			}
+
+			// Collapses each group of vertices into a single vertex, summing the weights between groups.  Each `group[u]` must be less than `count`.
+			inline compact_weighted_adjacency<double> _aggregate_weighted_adjacency(const compact_weighted_adjacency<double>& adj,
+				const std::vector<std::size_t>& group, std::size_t count) {
+				using size_type = std::size_t;
+				auto [members_offsets, members] = _counting_sort(group, count);
+				std::vector<std::vector<std::pair<size_type, double>>> rows(count);
+				#pragma omp parallel
+				{
+					sparse_accumulator<double> link(count);
+					#pragma omp for schedule(dynamic, 64)
+					for (size_type c = 0; c < count; ++c) {
+						for (auto i = members_offsets[c]; i < members_offsets[c + 1]; ++i) {
+							auto u = members[i];
+							for (auto j = adj.offsets[u]; j < adj.offsets[u + 1]; ++j)
+								link.add(group[adj.targets[j]], adj.weights[j]);
+						}
+						std::sort(link.touched.begin(), link.touched.end());
+						for (auto d : link.touched)
+							rows[c].emplace_back(d, link.values[d]);
+						link.clear();
+					}
+				}
+				compact_weighted_adjacency<double> result;
+				result.offsets.assign(count + 1, 0);
+				for (size_type c = 0; c < count; ++c)
+					result.offsets[c + 1] = result.offsets[c] + rows[c].size();
+				result.targets.resize(result.offsets[count]);
+				result.weights.resize(result.offsets[count]);
+				#pragma omp parallel for
+				for (size_type c = 0; c < count; ++c) {
+					for (size_type i = 0; i < rows[c].size(); ++i) {
+						result.targets[result.offsets[c] + i] = rows[c][i].first;
+						result.weights[result.offsets[c] + i] = rows[c][i].second;
+					}
+				}
+				return result;
+			}
+
+			// Gathers the adjacent edges of every vertex in parallel from the graph's adjacency lists.
+			template <class Adjacency, class G>
+			auto _compact_adjacent_edges(const G& g, const compact_index<G>& index) {
+				using Edges = traits::Edges<G>;
+				using Adjacencies = traits::Adjacent_edges<Adjacency, G>;
+				using size_type = std::size_t;
+				const size_type n = index.size();
+				compact_edge_adjacency<typename Edges::value_type> result;
+				result.offsets.assign(n + 1, 0);
+				#pragma omp parallel for
+				for (size_type i = 0; i < n; ++i)
+					result.offsets[i + 1] = Adjacencies::size(g, index[i]);
+				std::partial_sum(result.offsets.begin(), result.offsets.end(), result.offsets.begin());
+				result.targets.resize(result.offsets[n]);
+				result.edges.assign(result.offsets[n], Edges::null(g));
+				#pragma omp parallel for schedule(dynamic, 1024)
+				for (size_type i = 0; i < n; ++i) {
+					auto j = result.offsets[i];
+					for (auto e : Adjacencies::range(g, index[i])) {
+						result.targets[j] = index(traits::adjacency_cokey<Adjacency>(g, e));
+						result.edges[j++] = std::move(e);
+					}
+				}
+				return result;
+			}
+
+			// Groups all edges of a graph by their `Adjacency` key, which requires nothing more than the edge list.
+			template <class Adjacency, class G>
+			auto _compact_edges(const G& g, const compact_index<G>& index) {
+				using Edges = traits::Edges<G>;
+				using size_type = std::size_t;
+				std::vector<size_type> keys, cokeys;
+				std::vector<typename Edges::value_type> edges;
+				keys.reserve(Edges::size(g));
+				cokeys.reserve(Edges::size(g));
+				edges.reserve(Edges::size(g));
+				for (auto e : Edges::range(g)) {
+					keys.push_back(index(traits::adjacency_key<Adjacency>(g, e)));
+					cokeys.push_back(index(traits::adjacency_cokey<Adjacency>(g, e)));
+					edges.push_back(std::move(e));
+				}
+				auto [offsets, order] = _counting_sort(keys, index.size());
+				compact_edge_adjacency<typename Edges::value_type> result;
+				result.offsets = std::move(offsets);
+				result.targets.resize(order.size());
+				result.edges.assign(order.size(), Edges::null(g));
+				#pragma omp parallel for
+				for (size_type i = 0; i < order.size(); ++i) {
+					result.targets[i] = cokeys[order[i]];
+					result.edges[i] = edges[order[i]];
+				}
+				return result;
+			}
+
+			// Builds the simple, undirected graph underlying a graph: edge directions are ignored, and self-edges and parallel edges are dropped.  Each neighbor list is sorted by index.
+			template <class G>
+			compact_adjacency _compact_neighbors(const G& g, const compact_index<G>& index) {
+				using Edges = traits::Edges<G>;
+				using size_type = std::size_t;
+				std::vector<size_type> keys, cokeys;
+				keys.reserve(2 * Edges::size(g));
+				cokeys.reserve(2 * Edges::size(g));
+				for (auto e : Edges::range(g)) {
+					auto u = index(Edges::tail(g, e)), v = index(Edges::head(g, e));
+					if (u == v)
+						continue;
+					keys.push_back(u);
+					cokeys.push_back(v);
+					keys.push_back(v);
+					cokeys.push_back(u);
+				}
+				const size_type n = index.size();
+				auto [offsets, order] = _counting_sort(keys, n);
+				std::vector<size_type> targets(order.size()), degrees(n + 1, 0);
+				#pragma omp parallel for schedule(dynamic, 1024)
+				for (size_type u = 0; u < n; ++u) {
+					auto first = targets.begin() + offsets[u], last = targets.begin() + offsets[u + 1];
+					for (auto i = offsets[u]; i < offsets[u + 1]; ++i)
+						targets[i] = cokeys[order[i]];
+					std::sort(first, last);
+					degrees[u + 1] = std::unique(first, last) - first;
+				}
+				compact_adjacency result;
+				result.offsets = std::move(degrees);
+				std::partial_sum(result.offsets.begin(), result.offsets.end(), result.offsets.begin());
+				result.targets.resize(result.offsets[n]);
+				#pragma omp parallel for
+				for (size_type u = 0; u < n; ++u)
+					std::copy_n(targets.begin() + offsets[u], result.degree(u),
+						result.targets.begin() + result.offsets[u]);
+				return result;
+			}
+
+			// Builds the weighted, undirected graph underlying a graph: edge directions are ignored and parallel edges are combined by summing their weights.  Each self-edge appears once with twice its weight, so each row sums to the weighted degree of its vertex.  Each neighbor list is sorted by index.
+			template <class W, class G, class Weight>
+			compact_weighted_adjacency<W> _compact_weighted_neighbors(const G& g, const compact_index<G>& index, const Weight& weight) {
+				using Edges = traits::Edges<G>;
+				using size_type = std::size_t;
+				std::vector<size_type> keys, cokeys;
+				std::vector<W> weights;
+				keys.reserve(2 * Edges::size(g));
+				cokeys.reserve(2 * Edges::size(g));
+				weights.reserve(2 * Edges::size(g));
+				for (auto e : Edges::range(g)) {
+					auto u = index(Edges::tail(g, e)), v = index(Edges::head(g, e));
+					W w = weight(e);
+					keys.push_back(u);
+					cokeys.push_back(v);
+					if (u == v) {
+						weights.push_back(w + w);
+						continue;
+					}
+					weights.push_back(w);
+					keys.push_back(v);
+					cokeys.push_back(u);
+					weights.push_back(w);
+				}
+				const size_type n = index.size();
+				auto [offsets, order] = _counting_sort(keys, n);
+				std::vector<std::pair<size_type, W>> entries(order.size());
+				std::vector<size_type> degrees(n + 1, 0);
+				#pragma omp parallel for schedule(dynamic, 1024)
+				for (size_type u = 0; u < n; ++u) {
+					auto first = entries.begin() + offsets[u], last = entries.begin() + offsets[u + 1];
+					for (auto i = offsets[u]; i < offsets[u + 1]; ++i)
+						entries[i] = {cokeys[order[i]], weights[order[i]]};
+					std::sort(first, last, [](const auto& l, const auto& r) { return l.first < r.first; });
+					// Combine runs of parallel edges in place
+					auto out = first;
+					for (auto i = first; i != last; ++i) {
+						if (out != first && std::prev(out)->first == i->first)
+							std::prev(out)->second += i->second;
+						else
+							*out++ = *i;
+					}
+					degrees[u + 1] = out - first;
+				}
+				compact_weighted_adjacency<W> result;
+				result.offsets = std::move(degrees);
+				std::partial_sum(result.offsets.begin(), result.offsets.end(), result.offsets.begin());
+				result.targets.resize(result.offsets[n]);
+				result.weights.resize(result.offsets[n]);
+				#pragma omp parallel for
+				for (size_type u = 0; u < n; ++u) {
+					for (size_type i = 0; i < result.degree(u); ++i) {
+						result.targets[result.offsets[u] + i] = entries[offsets[u] + i].first;
+						result.weights[result.offsets[u] + i] = entries[offsets[u] + i].second;
+					}
+				}
+				return result;
+			}
+		}
+	}
+}
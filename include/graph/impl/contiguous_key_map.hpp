@@ -62,7 +62,7 @@ namespace graph {
 				using _container_type = std::vector<T>;
 				using key_type = K;
 				using value_type = T;
-				using const_reference = const T&;
+				using const_reference = typename _container_type::const_reference;
 				using reference = typename _container_type::reference;
 				using _inner_key_type = typename key_type::key_type;
 				static_assert(std::is_integral_v<_inner_key_type>);
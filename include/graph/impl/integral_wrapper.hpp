@@ -1,6 +1,7 @@
 #pragma once
 
 #include <limits>
+#include <type_traits>
 #include <ostream>
 
 namespace graph {
@@ -40,6 +41,13 @@ namespace graph {
 			private:
 				I _i;
 			};
+
+			template <class T>
+			struct is_integral_wrapper : std::false_type {};
+			template <class I, class Tag>
+			struct is_integral_wrapper<integral_wrapper<I, Tag>> : std::true_type {};
+			template <class T>
+			constexpr bool is_integral_wrapper_v = is_integral_wrapper<T>::value;
 		}
 	}
 }
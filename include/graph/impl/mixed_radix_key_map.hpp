@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "integral_wrapper.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			// Numbers the tuples of integral keys `(k_0, ..., k_n)`, with `k_i < radix_i`, contiguously in lexicographic order, which is the order in which a cartesian product enumerates them.
+			template <class Tuple, class... K>
+			struct mixed_radix_index {
+				static_assert((is_integral_wrapper_v<K> && ...));
+				static constexpr std::size_t rank = sizeof...(K);
+				using key_type = Tuple;
+				using index_type = integral_wrapper<std::size_t, struct mixed_radix_tag>;
+				mixed_radix_index() = default;
+				explicit mixed_radix_index(std::array<std::size_t, rank> radices) :
+					_radices(radices) {
+					for (auto i = rank; i-- > 0;) {
+						_strides[i] = _size;
+						_size *= _radices[i];
+					}
+				}
+				// @return The number of distinct indices.
+				std::size_t size() const {
+					return _size;
+				}
+				index_type operator()(const key_type& k) const {
+					return index_type(_index(k, std::index_sequence_for<K...>{}));
+				}
+				key_type operator[](std::size_t i) const {
+					return _key(i, std::index_sequence_for<K...>{});
+				}
+			private:
+				template <std::size_t... I>
+				std::size_t _index(const key_type& k, std::index_sequence<I...>) const {
+					return (std::size_t{0} + ... + (static_cast<std::size_t>(std::get<I>(k._tuple).key()) * _strides[I]));
+				}
+				template <std::size_t... I>
+				key_type _key(std::size_t i, std::index_sequence<I...>) const {
+					return key_type(typename key_type::tuple_type(
+						K(static_cast<typename K::key_type>(i / _strides[I] % _radices[I]))...));
+				}
+
+				std::array<std::size_t, rank> _radices{}, _strides{};
+				std::size_t _size = 1;
+			};
+
+			// Adapts a contiguous key map to tuple keys through a <mixed_radix_index>.
+			template <class Index, class T, template <class, class> class Map>
+			struct mixed_radix_key_map {
+				using _container_type = Map<typename Index::index_type, T>;
+				using key_type = typename Index::key_type;
+				using value_type = T;
+				using const_reference = typename _container_type::const_reference;
+				using reference = typename _container_type::reference;
+				mixed_radix_key_map(Index index, T default_) :
+					_index(std::move(index)), _map(_index.size(), std::move(default_)) {
+				}
+				const_reference operator()(const key_type& k) const {
+					return _map(_index(k));
+				}
+				reference operator[](const key_type& k) {
+					return _map[_index(k)];
+				}
+				template <class U>
+				void assign(const key_type& k, U&& u) {
+					_map.assign(_index(k), std::forward<U>(u));
+				}
+				template <class U>
+				T exchange(const key_type& k, U&& u) {
+					return _map.exchange(_index(k), std::forward<U>(u));
+				}
+			private:
+				Index _index;
+				_container_type _map;
+			};
+
+			// Set of tuple keys stored as one bit per index of a <mixed_radix_index>, with a vector of its elements for iteration.  Erasing searches the vector, so it takes time linear in the size of the set, but no space beyond the bits.
+			template <class Index>
+			struct mixed_radix_key_set {
+				using key_type = typename Index::key_type;
+				using _container_type = std::vector<key_type>;
+				using size_type = typename _container_type::size_type;
+				using iterator = typename _container_type::const_iterator;
+				explicit mixed_radix_key_set(Index index) :
+					_index(std::move(index)), _flags(_index.size(), false) {
+				}
+				auto size() const {
+					return _container.size();
+				}
+				bool contains(const key_type& k) const {
+					return _flags[_index(k).key()];
+				}
+				bool insert(const key_type& k) {
+					auto flag = _flags[_index(k).key()];
+					if (flag)
+						return false;
+					flag = true;
+					_container.push_back(k);
+					return true;
+				}
+				bool erase(const key_type& k) {
+					auto flag = _flags[_index(k).key()];
+					if (!flag)
+						return false;
+					flag = false;
+					// Order is not kept, so the last element fills the gap
+					auto it = std::find(_container.begin(), _container.end(), k);
+					*it = std::move(_container.back());
+					_container.pop_back();
+					return true;
+				}
+				void clear() {
+					for (const auto& k : _container)
+						_flags[_index(k).key()] = false;
+					_container.clear();
+				}
+				iterator begin() const {
+					return _container.begin();
+				}
+				iterator end() const {
+					return _container.end();
+				}
+				bool operator==(const mixed_radix_key_set& other) const {
+					// As with contiguous sets, both are assumed to share a domain.
+					return _flags == other._flags;
+				}
+				bool operator!=(const mixed_radix_key_set& other) const {
+					return !(*this == other);
+				}
+			private:
+				Index _index;
+				std::vector<bool> _flags;
+				_container_type _container;
+			};
+		}
+	}
+}
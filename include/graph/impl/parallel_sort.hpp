@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include "omp.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			// Sorts `values` by sorting one contiguous chunk per thread, then merging neighboring chunks in parallel rounds.
+			template <class T, class Compare>
+			void _parallel_sort(std::vector<T>& values, const Compare& compare) {
+				using size_type = std::size_t;
+				const size_type size = values.size();
+				const size_type chunks = std::max<size_type>(1, std::min<size_type>(omp_get_max_threads(), size / 1024));
+				if (chunks == 1) {
+					std::sort(values.begin(), values.end(), compare);
+					return;
+				}
+				auto bound = [&](size_type i) {
+					return values.begin() + std::min(size, size * i / chunks);
+				};
+				#pragma omp parallel for
+				for (size_type i = 0; i < chunks; ++i)
+					std::sort(bound(i), bound(i + 1), compare);
+				for (size_type width = 1; width < chunks; width *= 2) {
+					#pragma omp parallel for
+					for (size_type i = 0; i < chunks; i += 2 * width)
+						if (i + width < chunks)
+							std::inplace_merge(bound(i), bound(i + width), bound(std::min(chunks, i + 2 * width)), compare);
+				}
+			}
+		}
+	}
+}
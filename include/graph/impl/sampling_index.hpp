@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vector>
+#include <random>
+#include <utility>
+#include <type_traits>
+
+#include "exceptions.hpp"
+#include "unordered_key_map.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			struct identity_fn {
+				template <class T>
+				const T& operator()(const T& x) const noexcept {
+					return x;
+				}
+			};
+
+			// Dense array of the elements of a container which do not support random access, so that an element can be sampled uniformly in constant time.  Each element is erased by moving the last one into its place, which requires finding its position from a key projected by `Key`.
+			template <class T, class Key = identity_fn>
+			struct sampling_index {
+				using size_type = std::size_t;
+				sampling_index() :
+					_position(size_type{}) {
+				}
+				size_type size() const noexcept {
+					return _items.size();
+				}
+				void insert(T x) {
+					_position.assign(Key{}(x), _items.size());
+					_items.push_back(std::move(x));
+				}
+				void erase(const T& x) {
+					auto i = _position(Key{}(x));
+					_position._erase(Key{}(x));
+					if (i + 1 != _items.size()) {
+						_items[i] = std::move(_items.back());
+						_position.assign(Key{}(_items[i]), i);
+					}
+					_items.pop_back();
+				}
+				void clear() {
+					_items.clear();
+					_position._clear();
+				}
+				template <class Random>
+				const T& sample(Random& r) const {
+					check_precondition(!_items.empty(), "size must be positive");
+					return _items[std::uniform_int_distribution<size_type>(0, _items.size() - 1)(r)];
+				}
+			private:
+				std::vector<T> _items;
+				unordered_key_map<std::decay_t<decltype(Key{}(std::declval<const T&>()))>, size_type> _position;
+			};
+		}
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			// SplitMix64, which is cheap enough to seed for every unit of parallel work, so results do not depend on how the work is scheduled across threads.
+			struct _splitmix64 {
+				using result_type = std::uint64_t;
+				result_type state;
+				static constexpr result_type min() {
+					return 0;
+				}
+				static constexpr result_type max() {
+					return ~result_type{0};
+				}
+				// @return A generator for the `i`th of many independent streams drawn from `seed`.
+				static _splitmix64 stream(result_type seed, result_type i) {
+					return _splitmix64{_splitmix64{seed + i * 0xd1b54a32d192ed03}()};
+				}
+				result_type operator()() {
+					auto z = (state += 0x9e3779b97f4a7c15);
+					z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+					z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+					return z ^ (z >> 31);
+				}
+				// @return A uniformly distributed number in `[0, 1)`.
+				double uniform() {
+					return static_cast<double>((*this)() >> 11) * (1.0 / 9007199254740992.0);
+				}
+				// @return A uniformly distributed integer in `[0, n)`.
+				std::size_t below(std::size_t n) {
+					return std::min(static_cast<std::size_t>(uniform() * n), n - 1);
+				}
+			};
+		}
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <utility>
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			// Disjoint sets over `[0, size)` with union by rank and path compression.
+			struct union_find {
+				using size_type = std::size_t;
+				explicit union_find(size_type size) :
+					_parent(size), _rank(size, 0) {
+					for (size_type i = 0; i < size; ++i)
+						_parent[i] = i;
+				}
+				size_type size() const {
+					return _parent.size();
+				}
+				size_type find(size_type x) {
+					auto root = x;
+					while (_parent[root] != root)
+						root = _parent[root];
+					while (_parent[x] != root)
+						x = std::exchange(_parent[x], root);
+					return root;
+				}
+				// @return True if and only if `x` and `y` were in different sets.
+				bool unite(size_type x, size_type y) {
+					x = find(x);
+					y = find(y);
+					if (x == y)
+						return false;
+					if (_rank[x] < _rank[y])
+						std::swap(x, y);
+					_parent[y] = x;
+					if (_rank[x] == _rank[y])
+						++_rank[x];
+					return true;
+				}
+			private:
+				std::vector<size_type> _parent;
+				std::vector<unsigned char> _rank;
+			};
+
+			// Lock-free disjoint sets over `[0, size)`.  Roots are always linked beneath smaller roots, so concurrent unions can never form a cycle.
+			struct concurrent_union_find {
+				using size_type = std::size_t;
+				explicit concurrent_union_find(size_type size) :
+					_parent(size) {
+					#pragma omp parallel for
+					for (size_type i = 0; i < size; ++i)
+						_parent[i].store(i, std::memory_order_relaxed);
+				}
+				size_type size() const {
+					return _parent.size();
+				}
+				// Finds the root of the set containing `x`, halving the path to it along the way.
+				size_type find(size_type x) {
+					for (;;) {
+						auto p = _parent[x].load(std::memory_order_relaxed);
+						if (p == x)
+							return x;
+						auto q = _parent[p].load(std::memory_order_relaxed);
+						if (p != q)
+							_parent[x].compare_exchange_weak(p, q, std::memory_order_relaxed);
+						x = q;
+					}
+				}
+				// @return True if and only if `x` and `y` were in different sets.
+				bool unite(size_type x, size_type y) {
+					for (;;) {
+						x = find(x);
+						y = find(y);
+						if (x == y)
+							return false;
+						if (x < y)
+							std::swap(x, y);
+						if (_parent[x].compare_exchange_strong(x, y, std::memory_order_relaxed))
+							return true;
+					}
+				}
+			private:
+				std::vector<std::atomic<size_type>> _parent;
+			};
+		}
+	}
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <vector>
+#include <limits>
+
+#include "impl/compact_adjacency.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			// Hopcroft-Karp over a compact out-adjacency, considering only entries from `left` vertices to the others.
+			// @return The adjacency entry matching each left vertex, or `none` if it is unmatched.
+			template <class Edge>
+			std::vector<std::size_t> _hopcroft_karp(const compact_edge_adjacency<Edge>& adj, const std::vector<char>& left) {
+				using size_type = std::size_t;
+				const size_type n = adj.order(), none = std::numeric_limits<size_type>::max(), inf = none;
+				std::vector<size_type> mate(n, none), matched_by(n, none), distance(n), current(n), queue, stack;
+				auto eligible = [&](size_type u, size_type v) {
+					return v != u && !left[v];
+				};
+				// Start from a greedy matching, which usually leaves few phases to run
+				for (size_type u = 0; u < n; ++u) {
+					if (!left[u])
+						continue;
+					for (auto j = adj.offsets[u]; j < adj.offsets[u + 1]; ++j) {
+						auto v = adj.targets[j];
+						if (eligible(u, v) && matched_by[v] == none) {
+							mate[u] = j;
+							matched_by[v] = u;
+							break;
+						}
+					}
+				}
+				for (;;) {
+					// Layer the left vertices by breadth-first search from the unmatched ones
+					queue.clear();
+					for (size_type u = 0; u < n; ++u) {
+						distance[u] = inf;
+						if (left[u] && mate[u] == none) {
+							distance[u] = 0;
+							queue.push_back(u);
+						}
+					}
+					size_type found = inf;
+					for (size_type i = 0; i < queue.size(); ++i) {
+						auto u = queue[i];
+						if (distance[u] >= found)
+							continue;
+						for (auto j = adj.offsets[u]; j < adj.offsets[u + 1]; ++j) {
+							auto v = adj.targets[j];
+							if (!eligible(u, v))
+								continue;
+							auto w = matched_by[v];
+							if (w == none) {
+								found = std::min(found, distance[u] + 1);
+							} else if (distance[w] == inf) {
+								distance[w] = distance[u] + 1;
+								queue.push_back(w);
+							}
+						}
+					}
+					if (found == inf)
+						break;
+					// Augment along vertex-disjoint shortest paths by iterative depth-first search
+					for (size_type u = 0; u < n; ++u)
+						current[u] = adj.offsets[u];
+					for (size_type root = 0; root < n; ++root) {
+						if (!left[root] || mate[root] != none || distance[root] != 0)
+							continue;
+						stack.assign(1, root);
+						while (!stack.empty()) {
+							auto u = stack.back();
+							if (current[u] == adj.offsets[u + 1]) {
+								// Dead end, so remove `u` from the layering
+								distance[u] = inf;
+								stack.pop_back();
+								if (!stack.empty())
+									++current[stack.back()];
+								continue;
+							}
+							auto v = adj.targets[current[u]];
+							if (!eligible(u, v)) {
+								++current[u];
+								continue;
+							}
+							auto w = matched_by[v];
+							if (w == none) {
+								if (distance[u] + 1 != found) {
+									++current[u];
+									continue;
+								}
+								for (auto x : stack) {
+									mate[x] = current[x];
+									matched_by[adj.targets[current[x]]] = x;
+								}
+								break;
+							}
+							if (distance[w] == distance[u] + 1)
+								stack.push_back(w);
+							else
+								++current[u];
+						}
+					}
+				}
+				return mate;
+			}
+		}
+		template <class Impl>
+		template <class Set>
+		auto Out_edge_graph<Impl>::maximum_bipartite_matching(const Set& left) const {
+			const auto& g = this->_impl();
+			auto index = impl::compact_index(g);
+			auto adj = impl::_compact_adjacent_edges<impl::traits::Out>(g, index);
+			std::vector<char> is_left(index.size());
+			for (std::size_t u = 0; u < index.size(); ++u)
+				is_left[u] = left.contains(index[u]);
+			auto mate = impl::_hopcroft_karp(adj, is_left);
+			auto result = this->vert_map(this->null_edge());
+			for (std::size_t u = 0; u < index.size(); ++u) {
+				if (!is_left[u] || mate[u] == std::numeric_limits<std::size_t>::max())
+					continue;
+				const auto& e = adj.edges[mate[u]];
+				result[index[u]] = e;
+				result[index[adj.targets[mate[u]]]] = e;
+			}
+			return result;
+		}
+	}
+}
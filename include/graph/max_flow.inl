@@ -0,0 +1,239 @@
+#pragma once
+
+#include <vector>
+#include <tuple>
+#include <algorithm>
+#include <type_traits>
+
+#include "impl/exceptions.hpp"
+#include "impl/compact_adjacency.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			// Highest-label push-relabel over compact arrays.  Edges are identified by their position in the out-adjacency, and the residual arcs of each vertex are its out-edges (forward) followed by its in-edges (backward).
+			template <class C>
+			struct _push_relabel {
+				using size_type = std::size_t;
+				std::vector<size_type> out_offsets, head, tail, in_offsets, in_edges;
+				std::vector<C> capacity, flow, excess;
+				std::vector<size_type> height, current;
+				// Active vertices bucketed by height
+				std::vector<std::vector<size_type>> active;
+				// Doubly-linked lists of all vertices by height, used to detect gaps during the first phase
+				std::vector<size_type> first, next, prev;
+				size_type n, s, t, highest = 0, max_height = 0, work = 0;
+
+				size_type arcs(size_type u) const {
+					return out_offsets[u + 1] - out_offsets[u] + in_offsets[u + 1] - in_offsets[u];
+				}
+				// @return The edge behind the `k`th residual arc of `u`, and whether the arc is forward.
+				std::pair<size_type, bool> arc(size_type u, size_type k) const {
+					auto out_degree = out_offsets[u + 1] - out_offsets[u];
+					if (k < out_degree)
+						return {out_offsets[u] + k, true};
+					return {in_edges[in_offsets[u] + k - out_degree], false};
+				}
+				C residual(size_type j, bool forward) const {
+					return forward ? capacity[j] - flow[j] : flow[j];
+				}
+
+				void insert(size_type v, size_type h) {
+					next[v] = first[h];
+					prev[v] = n;
+					if (first[h] != n)
+						prev[first[h]] = v;
+					first[h] = v;
+					max_height = std::max(max_height, h);
+				}
+				void remove(size_type v, size_type h) {
+					if (prev[v] != n)
+						next[prev[v]] = next[v];
+					else
+						first[h] = next[v];
+					if (next[v] != n)
+						prev[next[v]] = prev[v];
+				}
+				void activate(size_type v) {
+					active[height[v]].push_back(v);
+					highest = std::max(highest, height[v]);
+				}
+
+				// Sets every height to the distance to `root` in the residual graph plus `base`, found by a backward breadth-first search, or to `limit` if there is no such path.
+				void global_relabel(size_type root, size_type base, size_type limit, size_type fixed, bool gaps) {
+					std::fill(height.begin(), height.end(), limit);
+					height[root] = base;
+					std::vector<size_type> queue{root};
+					for (size_type i = 0; i < queue.size(); ++i) {
+						auto v = queue[i];
+						for (size_type k = 0, arcs_v = arcs(v); k < arcs_v; ++k) {
+							// The arc from `w` to `v` runs opposite to this arc of `v`
+							auto [j, forward] = arc(v, k);
+							auto w = forward ? head[j] : tail[j];
+							if (height[w] != limit || w == fixed || !(residual(j, !forward) > C{}))
+								continue;
+							height[w] = height[v] + 1;
+							queue.push_back(w);
+						}
+					}
+					height[fixed] = limit;
+					for (auto& bucket : active)
+						bucket.clear();
+					highest = 0;
+					if (gaps) {
+						std::fill(first.begin(), first.end(), n);
+						max_height = 0;
+					}
+					for (size_type v = 0; v < n; ++v) {
+						current[v] = 0;
+						if (v == s || v == t || height[v] >= limit)
+							continue;
+						if (gaps)
+							insert(v, height[v]);
+						if (excess[v] > C{})
+							activate(v);
+					}
+					work = 0;
+				}
+
+				// Pushes excess from `u` along admissible arcs until it is exhausted or `u` must be relabelled.
+				void discharge(size_type u, size_type limit, bool gaps) {
+					for (auto arcs_u = arcs(u); current[u] < arcs_u; ++current[u]) {
+						auto [j, forward] = arc(u, current[u]);
+						auto v = forward ? head[j] : tail[j];
+						auto r = residual(j, forward);
+						if (!(r > C{}) || height[u] != height[v] + 1)
+							continue;
+						auto d = std::min(excess[u], r);
+						flow[j] = forward ? flow[j] + d : flow[j] - d;
+						excess[u] -= d;
+						if (v != s && v != t && !(excess[v] > C{}))
+							activate(v);
+						excess[v] += d;
+						if (!(excess[u] > C{}))
+							return;
+					}
+					// Relabel
+					auto old = height[u];
+					size_type h = limit;
+					for (size_type k = 0, arcs_u = arcs(u); k < arcs_u; ++k) {
+						auto [j, forward] = arc(u, k);
+						auto v = forward ? head[j] : tail[j];
+						if (v != u && residual(j, forward) > C{})
+							h = std::min(h, height[v] + 1);
+					}
+					work += arcs(u) + 12;
+					current[u] = 0;
+					if (gaps) {
+						remove(u, old);
+						if (first[old] == n) {
+							// Nothing below the gap can reach anything above it, so the vertices above can no longer reach the sink
+							for (auto level = old + 1; level <= max_height; ++level) {
+								for (auto v = first[level]; v != n; v = next[v])
+									height[v] = limit;
+								first[level] = n;
+							}
+							max_height = old ? old - 1 : 0;
+							height[u] = limit;
+							return;
+						}
+					}
+					height[u] = std::min(h, limit);
+					if (height[u] == limit)
+						return;
+					if (gaps)
+						insert(u, height[u]);
+					activate(u);
+				}
+
+				void run(size_type root, size_type base, size_type limit, size_type fixed, bool gaps) {
+					const size_type m = head.size();
+					global_relabel(root, base, limit, fixed, gaps);
+					for (;;) {
+						if (active[highest].empty()) {
+							if (!highest)
+								break;
+							--highest;
+							continue;
+						}
+						auto u = active[highest].back();
+						active[highest].pop_back();
+						if (height[u] != highest || !(excess[u] > C{}))
+							continue;
+						discharge(u, limit, gaps);
+						if (work > 6 * n + m)
+							global_relabel(root, base, limit, fixed, gaps);
+					}
+				}
+			};
+		}
+		template <class Impl>
+		template <class Capacity>
+		auto Bi_edge_graph<Impl>::max_flow(const Vert& s, const Vert& t, const Capacity& capacity) const {
+			using C = std::decay_t<std::result_of_t<const Capacity&(Edge)>>;
+			using size_type = std::size_t;
+			impl::check_precondition(s != t, "source and sink must differ");
+			const auto& g = this->_impl();
+			auto index = impl::compact_index(g);
+			auto out = impl::_compact_adjacent_edges<impl::traits::Out>(g, index);
+			auto in = impl::_compact_adjacent_edges<impl::traits::In>(g, index);
+			const size_type n = index.size(), m = out.size();
+
+			impl::_push_relabel<C> pr;
+			pr.n = n;
+			pr.s = index(s);
+			pr.t = index(t);
+			pr.out_offsets = std::move(out.offsets);
+			pr.head = std::move(out.targets);
+			pr.tail.resize(m);
+			pr.capacity.resize(m);
+			auto id = impl::traits::Edges<Impl>::ephemeral_map(g, size_type{});
+			for (size_type u = 0; u < n; ++u) {
+				for (auto j = pr.out_offsets[u]; j < pr.out_offsets[u + 1]; ++j) {
+					pr.tail[j] = u;
+					pr.capacity[j] = capacity(out.edges[j]);
+					impl::check_precondition(!(pr.capacity[j] < C{}), "edges must have non-negative capacities");
+					id[out.edges[j]] = j;
+				}
+			}
+			pr.in_offsets = std::move(in.offsets);
+			pr.in_edges.resize(m);
+			for (size_type i = 0; i < m; ++i)
+				pr.in_edges[i] = id(in.edges[i]);
+			pr.flow.assign(m, C{});
+			pr.excess.assign(n, C{});
+			pr.height.assign(n, 0);
+			pr.current.assign(n, 0);
+			pr.active.resize(2 * n + 1);
+			pr.first.assign(n + 1, n);
+			pr.next.assign(n, n);
+			pr.prev.assign(n, n);
+
+			// Saturate the edges leaving the source
+			for (auto j = pr.out_offsets[pr.s]; j < pr.out_offsets[pr.s + 1]; ++j) {
+				if (pr.head[j] == pr.s)
+					continue;
+				pr.flow[j] = pr.capacity[j];
+				pr.excess[pr.head[j]] += pr.capacity[j];
+				pr.excess[pr.s] -= pr.capacity[j];
+			}
+
+			// The first phase finds a maximum preflow, and the vertices which can no longer reach the sink form a minimum cut
+			pr.run(pr.t, 0, n, pr.s, true);
+			pr.global_relabel(pr.t, 0, n, pr.s, false);
+			auto cut = this->ephemeral_vert_set();
+			for (size_type u = 0; u < n; ++u)
+				if (pr.height[u] >= n)
+					cut.insert(index[u]);
+			auto value = pr.excess[pr.t];
+
+			// The second phase returns any remaining excess to the source
+			pr.run(pr.s, n, 2 * n, pr.t, false);
+
+			auto flow = this->edge_map(C{});
+			for (size_type j = 0; j < m; ++j)
+				flow[out.edges[j]] = pr.flow[j];
+			return std::make_tuple(std::move(value), std::move(flow), std::move(cut));
+		}
+	}
+}
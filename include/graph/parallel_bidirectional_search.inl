@@ -141,9 +141,7 @@ namespace graph {
 				return this->null_path();
 
 			// Construct path from trees
-			return this->concatenate_paths(
-				s_tree.path_from_root_to(rendezvous),
-				t_tree.path_to_root_from(rendezvous));
+			return impl::_splice_tree_paths(this->_impl(), s_tree, t_tree, rendezvous);
 		}
 	}
 }
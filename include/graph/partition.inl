@@ -0,0 +1,325 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <queue>
+#include <tuple>
+#include <random>
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+
+#include "impl/exceptions.hpp"
+#include "impl/compact_adjacency.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			// A weighted, undirected graph being partitioned.  Self-entries, which contracted edges become, never count towards a cut.
+			struct _partition_graph {
+				compact_weighted_adjacency<double> adj;
+				std::vector<double> weight;
+				std::size_t order() const {
+					return adj.order();
+				}
+			};
+
+			inline double _bisection_cut(const _partition_graph& g, const std::vector<std::uint8_t>& side) {
+				double cut = 0;
+				for (std::size_t u = 0; u < g.order(); ++u)
+					for (auto j = g.adj.offsets[u]; j < g.adj.offsets[u + 1]; ++j)
+						if (side[u] != side[g.adj.targets[j]])
+							cut += g.adj.weights[j];
+				return cut / 2;
+			}
+
+			// Fiduccia–Mattheyses refinement of a bisection.  Each pass moves every vertex at most once, always making the best move that keeps each side within its `limit`, then rolls back to the best prefix of moves.  Until the sides are within their limits, reducing the excess is preferred to reducing the cut.
+			inline void _fm_refine(const _partition_graph& g, std::vector<std::uint8_t>& side, const double (&limit)[2], std::size_t max_passes = 8) {
+				using size_type = std::size_t;
+				const size_type n = g.order();
+				std::vector<double> gain(n);
+				std::vector<char> locked(n);
+				std::vector<size_type> moves;
+				for (size_type pass = 0; pass < max_passes; ++pass) {
+					double total[2] = {0, 0};
+					for (size_type u = 0; u < n; ++u)
+						total[side[u]] += g.weight[u];
+					std::priority_queue<std::pair<double, size_type>> queue[2];
+					for (size_type u = 0; u < n; ++u) {
+						gain[u] = 0;
+						for (auto j = g.adj.offsets[u]; j < g.adj.offsets[u + 1]; ++j)
+							if (g.adj.targets[j] != u)
+								gain[u] += side[g.adj.targets[j]] != side[u] ? g.adj.weights[j] : -g.adj.weights[j];
+						queue[side[u]].emplace(gain[u], u);
+					}
+					std::fill(locked.begin(), locked.end(), false);
+					moves.clear();
+					auto excess = [&] {
+						return std::max(0.0, total[0] - limit[0]) + std::max(0.0, total[1] - limit[1]);
+					};
+					double cut = _bisection_cut(g, side), best_cut = cut, best_excess = excess();
+					size_type best = 0;
+					// Give up on a pass after this many moves without improvement
+					const size_type patience = std::max<size_type>(64, n / 16);
+					while (moves.size() - best < patience) {
+						// Discard stale entries, then pick the best feasible move
+						size_type u = n;
+						for (int s : {0, 1}) {
+							auto& q = queue[s];
+							while (!q.empty() && (locked[q.top().second] || side[q.top().second] != s || gain[q.top().second] != q.top().first))
+								q.pop();
+							if (q.empty())
+								continue;
+							auto v = q.top().second;
+							// A move is feasible if it fits, or at least reduces the excess
+							auto fits = total[1 - s] + g.weight[v] <= limit[1 - s] || total[s] > limit[s];
+							if (fits && (u == n || gain[v] > gain[u] || (gain[v] == gain[u] && total[s] > total[side[u]])))
+								u = v;
+						}
+						if (u == n)
+							break;
+						int from = side[u], to = 1 - from;
+						queue[from].pop();
+						locked[u] = true;
+						side[u] = to;
+						total[from] -= g.weight[u];
+						total[to] += g.weight[u];
+						cut -= gain[u];
+						moves.push_back(u);
+						for (auto j = g.adj.offsets[u]; j < g.adj.offsets[u + 1]; ++j) {
+							auto v = g.adj.targets[j];
+							if (v == u || locked[v])
+								continue;
+							gain[v] += side[v] == to ? -2 * g.adj.weights[j] : 2 * g.adj.weights[j];
+							queue[side[v]].emplace(gain[v], v);
+						}
+						auto e = excess();
+						if (e < best_excess || (e == best_excess && cut < best_cut)) {
+							best_excess = e;
+							best_cut = cut;
+							best = moves.size();
+						}
+					}
+					for (auto i = moves.size(); i > best; --i)
+						side[moves[i - 1]] ^= 1;
+					if (!best)
+						break;
+				}
+			}
+
+			// Greedy graph growing: side zero grows breadth-first from a random vertex until it reaches its target weight, restarting from another random vertex whenever a region is exhausted.
+			inline std::vector<std::uint8_t> _grow_bisection(const _partition_graph& g, double target, std::mt19937_64& r) {
+				using size_type = std::size_t;
+				const size_type n = g.order();
+				std::vector<std::uint8_t> side(n, 1);
+				std::vector<size_type> queue, seeds(n);
+				// Draw starts from a single permutation, so that many small components cost linear time in all
+				std::iota(seeds.begin(), seeds.end(), 0);
+				std::shuffle(seeds.begin(), seeds.end(), r);
+				double total = 0;
+				size_type head = 0, next = 0;
+				while (total < target) {
+					if (head == queue.size()) {
+						while (next < n && !side[seeds[next]])
+							++next;
+						if (next == n)
+							break;
+						auto s = seeds[next++];
+						side[s] = 0;
+						queue.push_back(s);
+						total += g.weight[s];
+						continue;
+					}
+					auto u = queue[head++];
+					for (auto v = g.adj.begin(u); v != g.adj.end(u) && total < target; ++v) {
+						if (side[*v]) {
+							side[*v] = 0;
+							queue.push_back(*v);
+							total += g.weight[*v];
+						}
+					}
+				}
+				return side;
+			}
+
+			// Heavy-edge matching, visiting vertices in random order, and contraction of matched pairs without letting any vertex exceed `max_weight`.  As in METIS, vertices left unmatched are then paired with others which share a neighbor, and isolated vertices with each other, so that coarsening keeps making progress on graphs with many small components.
+			// @return The coarser graph and the coarse vertex of each vertex.
+			inline std::pair<_partition_graph, std::vector<std::size_t>> _coarsen(const _partition_graph& g, double max_weight, std::mt19937_64& r) {
+				using size_type = std::size_t;
+				const size_type n = g.order(), none = n;
+				std::vector<size_type> visit(n), match(n, none), coarse(n);
+				std::iota(visit.begin(), visit.end(), 0);
+				std::shuffle(visit.begin(), visit.end(), r);
+				for (auto u : visit) {
+					if (match[u] != none)
+						continue;
+					match[u] = u;
+					double heaviest = 0;
+					for (auto j = g.adj.offsets[u]; j < g.adj.offsets[u + 1]; ++j) {
+						auto v = g.adj.targets[j];
+						if (v != u && match[v] == none && g.adj.weights[j] > heaviest && g.weight[u] + g.weight[v] <= max_weight)
+							heaviest = g.adj.weights[j], match[u] = v;
+					}
+					match[match[u]] = u;
+				}
+				// Pair the leftovers, keeping for each neighbor, and for isolated vertices, one which still waits for a partner
+				std::vector<size_type> waiting(n + 1, none);
+				for (auto u : visit) {
+					if (match[u] != u)
+						continue;
+					auto key = n;
+					for (auto j = g.adj.offsets[u]; j < g.adj.offsets[u + 1] && key == n; ++j)
+						if (g.adj.targets[j] != u)
+							key = g.adj.targets[j];
+					auto v = waiting[key];
+					if (v != none && g.weight[u] + g.weight[v] <= max_weight) {
+						match[u] = v, match[v] = u;
+						waiting[key] = none;
+					} else
+						waiting[key] = u;
+				}
+				size_type count = 0;
+				for (size_type u = 0; u < n; ++u)
+					if (match[u] >= u)
+						coarse[u] = count++;
+				for (size_type u = 0; u < n; ++u)
+					if (match[u] < u)
+						coarse[u] = coarse[match[u]];
+				_partition_graph result{_aggregate_weighted_adjacency(g.adj, coarse, count), std::vector<double>(count, 0)};
+				for (size_type u = 0; u < n; ++u)
+					result.weight[coarse[u]] += g.weight[u];
+				return {std::move(result), std::move(coarse)};
+			}
+
+			// Multilevel bisection, after Karypis and Kumar: coarsen by heavy-edge matching, bisect the coarsest graph by greedy growing from several starts, then project the bisection back, refining it at every level.
+			// @return The side of each vertex, where side zero should have `fraction` of the total weight.
+			inline std::vector<std::uint8_t> _multilevel_bisection(const _partition_graph& g, double fraction, double epsilon, std::mt19937_64& r) {
+				using size_type = std::size_t;
+				constexpr size_type coarsest = 64, tries = 4;
+				const double total = std::accumulate(g.weight.begin(), g.weight.end(), 0.0);
+				const double max_weight = g.order() ? *std::max_element(g.weight.begin(), g.weight.end()) : 0;
+				// Leave room for at least one vertex on either side, so moves remain possible
+				const double limit[2] = {
+					std::max(fraction * total * (1 + epsilon), fraction * total + max_weight),
+					std::max((1 - fraction) * total * (1 + epsilon), (1 - fraction) * total + max_weight)};
+				std::vector<_partition_graph> levels;
+				std::vector<std::vector<size_type>> maps;
+				const _partition_graph *current = &g;
+				while (current->order() > coarsest) {
+					auto [coarser, map] = _coarsen(*current, std::max(1.5 * total / coarsest, max_weight), r);
+					// Stop once matching stalls
+					if (coarser.order() > 0.9 * current->order())
+						break;
+					levels.push_back(std::move(coarser));
+					maps.push_back(std::move(map));
+					current = &levels.back();
+				}
+				std::vector<std::uint8_t> side;
+				double best_cut = 0, best_excess = 0;
+				for (size_type t = 0; t < tries; ++t) {
+					auto candidate = _grow_bisection(*current, fraction * total, r);
+					_fm_refine(*current, candidate, limit);
+					double w0 = 0;
+					for (size_type u = 0; u < current->order(); ++u)
+						if (!candidate[u])
+							w0 += current->weight[u];
+					auto excess = std::max(0.0, w0 - limit[0]) + std::max(0.0, total - w0 - limit[1]);
+					auto cut = _bisection_cut(*current, candidate);
+					if (side.empty() || excess < best_excess || (excess == best_excess && cut < best_cut))
+						side = std::move(candidate), best_cut = cut, best_excess = excess;
+				}
+				for (auto i = levels.size(); i-- > 0;) {
+					const auto& finer = i ? levels[i - 1] : g;
+					std::vector<std::uint8_t> projected(finer.order());
+					for (size_type u = 0; u < finer.order(); ++u)
+						projected[u] = side[maps[i][u]];
+					side = std::move(projected);
+					_fm_refine(finer, side, limit);
+				}
+				return side;
+			}
+
+			// @return The subgraph induced by `verts`, numbered by their positions in it.
+			inline _partition_graph _induced_subgraph(const _partition_graph& g, const std::vector<std::size_t>& verts) {
+				using size_type = std::size_t;
+				const size_type none = g.order();
+				std::vector<size_type> local(g.order(), none);
+				for (size_type i = 0; i < verts.size(); ++i)
+					local[verts[i]] = i;
+				_partition_graph result;
+				result.adj.offsets.assign(1, 0);
+				for (auto u : verts) {
+					for (auto j = g.adj.offsets[u]; j < g.adj.offsets[u + 1]; ++j) {
+						if (local[g.adj.targets[j]] != none) {
+							result.adj.targets.push_back(local[g.adj.targets[j]]);
+							result.adj.weights.push_back(g.adj.weights[j]);
+						}
+					}
+					result.adj.offsets.push_back(result.adj.targets.size());
+					result.weight.push_back(g.weight[u]);
+				}
+				return result;
+			}
+
+			// Splits `g` into parts `[first, first + k)` by recursive multilevel bisection, recording the part of the `i`th vertex of `g` at `part[verts[i]]`.
+			inline void _recursive_bisection(const _partition_graph& g, const std::vector<std::size_t>& verts, std::size_t k, std::size_t first,
+				std::vector<std::size_t>& part, double epsilon, std::mt19937_64& r) {
+				using size_type = std::size_t;
+				if (k == 1 || g.order() == 0) {
+					for (auto v : verts)
+						part[v] = first;
+					return;
+				}
+				const size_type k0 = k / 2;
+				auto side = _multilevel_bisection(g, static_cast<double>(k0) / k, epsilon, r);
+				std::vector<size_type> local[2], global[2];
+				for (size_type u = 0; u < g.order(); ++u) {
+					local[side[u]].push_back(u);
+					global[side[u]].push_back(verts[u]);
+				}
+				_recursive_bisection(_induced_subgraph(g, local[0]), global[0], k0, first, part, epsilon, r);
+				_recursive_bisection(_induced_subgraph(g, local[1]), global[1], k - k0, first + k0, part, epsilon, r);
+			}
+
+			inline std::vector<std::size_t> _partition(const _partition_graph& g, std::size_t k, double epsilon) {
+				std::vector<std::size_t> part(g.order()), verts(g.order());
+				std::iota(verts.begin(), verts.end(), 0);
+				// Share the imbalance allowed among the levels of bisection, since it compounds
+				double levels = std::ceil(std::log2(static_cast<double>(k)));
+				if (levels > 1)
+					epsilon = std::pow(1 + epsilon, 1 / levels) - 1;
+				// A fixed seed keeps partitions reproducible
+				std::mt19937_64 r;
+				_recursive_bisection(g, verts, k, 0, part, epsilon, r);
+				return part;
+			}
+		}
+		template <class Impl>
+		template <class Vert_weight, class Edge_weight>
+		auto Graph<Impl>::partition(Order k, const Vert_weight& vert_weight, const Edge_weight& edge_weight) const {
+			using size_type = std::size_t;
+			impl::check_precondition(k > 0, "number of parts must be positive");
+			auto index = impl::compact_index(this->_impl());
+			const size_type n = index.size();
+			impl::_partition_graph g{impl::_compact_weighted_neighbors<double>(this->_impl(), index, edge_weight), std::vector<double>(n)};
+			for (size_type u = 0; u < n; ++u)
+				g.weight[u] = vert_weight(index[u]);
+			auto part = impl::_partition(g, k, 0.03);
+			auto result = vert_map(Order{});
+			std::vector<double> part_weight(k, 0);
+			double cut = 0;
+			for (size_type u = 0; u < n; ++u) {
+				result[index[u]] = static_cast<Order>(part[u]);
+				part_weight[part[u]] += g.weight[u];
+				for (auto j = g.adj.offsets[u]; j < g.adj.offsets[u + 1]; ++j)
+					if (part[u] != part[g.adj.targets[j]])
+						cut += g.adj.weights[j];
+			}
+			return std::make_tuple(std::move(result), cut / 2, std::move(part_weight));
+		}
+		template <class Impl>
+		auto Graph<Impl>::partition(Order k) const {
+			return partition(k, [](const Vert&) { return 1.0; }, [](const Edge&) { return 1.0; });
+		}
+	}
+}
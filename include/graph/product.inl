@@ -4,6 +4,7 @@
 
 namespace graph {
 	inline namespace v1 {
+		// Constructs a view of the tensor product of graphs, which has out-edges or in-edges when every factor does.
 		template <class... G>
 		auto tensor_product_view(const Graph<G>&... g) {
 			return _wrap_graph(impl::Tensor_product(&g._impl()...));
@@ -2,6 +2,9 @@
 
 #include <type_traits>
 #include <random>
+#include <vector>
+#include <optional>
+#include <algorithm>
 #include <range/v3/range_traits.hpp>
 
 // See `graph::impl::sample_one` below
@@ -20,7 +23,7 @@ namespace graph {
 				//ranges::sample(std::forward<Range>(range), a, random);
 				//return a[0];
 
-				using size_type = ranges::range_size_type_t<Range>;
+				using size_type = std::size_t;
 				if constexpr (ranges::RandomAccessRange<Range>()) {
 					// Optimized case when range supports random access
 					auto size = ranges::size(range);
@@ -29,24 +32,103 @@ namespace graph {
 					return ranges::at(std::forward<Range>(range), index_dist(random));
 				}
 				
-				std::decay_t<ranges::range_value_type_t<Range>> a;
+				// Not every value type is default constructible
+				std::optional<std::decay_t<ranges::range_value_type_t<Range>>> a;
 				size_type size = 0;
 				for (auto b : std::forward<Range>(range))
 					if (!std::uniform_int_distribution<size_type>(0, size++)(random))
-						a = b;
+						a.emplace(b);
 				check_precondition(size > 0, "size must be positive");
-				return a;
+				return std::move(*a);
 			}
+
+			// Draws `k` elements of a range of `size` elements uniformly and independently at random.  Unless the range supports random access, this makes a single pass over it for the whole batch rather than one per element.
+			template <class Range, class Random>
+			auto sample_many(Range&& range, std::size_t size, std::size_t k, Random& random) {
+				using value_type = std::decay_t<ranges::range_value_type_t<Range>>;
+				using size_type = std::size_t;
+				std::vector<value_type> result;
+				if (!k)
+					return result;
+				check_precondition(size > 0, "size must be positive");
+				std::uniform_int_distribution<size_type> index_dist(0, static_cast<size_type>(size-1));
+				result.reserve(k);
+				if constexpr (ranges::RandomAccessRange<Range>()) {
+					for (std::size_t i = 0; i < k; ++i)
+						result.push_back(ranges::at(range, index_dist(random)));
+				} else {
+					// Sort the drawn indices, remembering where each belongs in the result
+					std::vector<std::pair<size_type, std::size_t>> indices(k);
+					for (std::size_t i = 0; i < k; ++i)
+						indices[i] = {index_dist(random), i};
+					std::sort(indices.begin(), indices.end());
+					std::vector<std::optional<value_type>> drawn(k);
+					auto next = indices.begin();
+					size_type index = 0;
+					for (auto x : std::forward<Range>(range)) {
+						for (; next != indices.end() && next->first == index; ++next)
+							drawn[next->second].emplace(x);
+						if (next == indices.end())
+							break;
+						++index;
+					}
+					for (auto& x : drawn)
+						result.push_back(std::move(*x));
+				}
+				return result;
+			}
+
+			// Implementations which cannot sample their vertices or edges efficiently through their ranges may provide `random_vert` or `random_edge` themselves.
+			template <class G, class Random, class = void>
+			struct _has_random_vert : std::false_type {};
+			template <class G, class Random>
+			struct _has_random_vert<G, Random,
+				std::void_t<decltype(std::declval<const G&>().random_vert(std::declval<Random&>()))>> : std::true_type {};
+			template <class G, class Random, class = void>
+			struct _has_random_edge : std::false_type {};
+			template <class G, class Random>
+			struct _has_random_edge<G, Random,
+				std::void_t<decltype(std::declval<const G&>().random_edge(std::declval<Random&>()))>> : std::true_type {};
 		}
 		template <class Impl>
 		template <class Random>
 		auto Graph<Impl>::random_vert(Random& r) const -> Vert {
-			return impl::sample_one(verts(), r);
+			if constexpr (impl::_has_random_vert<Impl, Random>{})
+				return this->_impl().random_vert(r);
+			else
+				return impl::sample_one(verts(), r);
 		}
 		template <class Impl>
 		template <class Random>
 		auto Graph<Impl>::random_edge(Random& r) const -> Edge {
-			return impl::sample_one(edges(), r);
+			if constexpr (impl::_has_random_edge<Impl, Random>{})
+				return this->_impl().random_edge(r);
+			else
+				return impl::sample_one(edges(), r);
+		}
+		template <class Impl>
+		template <class Random>
+		auto Graph<Impl>::random_verts(Random& r, Order k) const -> std::vector<Vert> {
+			if constexpr (impl::_has_random_vert<Impl, Random>{}) {
+				std::vector<Vert> result;
+				result.reserve(k);
+				for (Order i = 0; i < k; ++i)
+					result.push_back(this->_impl().random_vert(r));
+				return result;
+			} else
+				return impl::sample_many(verts(), order(), k, r);
+		}
+		template <class Impl>
+		template <class Random>
+		auto Graph<Impl>::random_edges(Random& r, Size k) const -> std::vector<Edge> {
+			if constexpr (impl::_has_random_edge<Impl, Random>{}) {
+				std::vector<Edge> result;
+				result.reserve(k);
+				for (Size i = 0; i < k; ++i)
+					result.push_back(this->_impl().random_edge(r));
+				return result;
+			} else
+				return impl::sample_many(edges(), size(), k, r);
 		}
 	}
 }
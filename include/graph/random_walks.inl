@@ -0,0 +1,167 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include "impl/exceptions.hpp"
+#include "impl/omp.hpp"
+#include "impl/compact_adjacency.hpp"
+#include "impl/splitmix64.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			// Alias tables over the rows of a <compact_adjacency>, which sample an entry of a row in proportion to its weight in constant time.
+			struct _alias_tables {
+				using size_type = std::size_t;
+				const compact_adjacency& adj;
+				std::vector<double> probability;
+				std::vector<size_type> alias;
+				// Rows with no positive weight, from which nothing can be sampled
+				std::vector<char> empty;
+
+				template <class W>
+				_alias_tables(const compact_adjacency& adj, const std::vector<W>& weight) :
+					adj(adj), probability(adj.size()), alias(adj.size()), empty(adj.order(), false) {
+					const size_type n = adj.order();
+					#pragma omp parallel
+					{
+						std::vector<size_type> small, large;
+						#pragma omp for schedule(dynamic, 1024)
+						for (size_type u = 0; u < n; ++u) {
+							const size_type offset = adj.offsets[u], degree = adj.degree(u);
+							double total = 0;
+							for (size_type i = 0; i < degree; ++i)
+								total += static_cast<double>(weight[offset + i]);
+							if (!(total > 0)) {
+								empty[u] = true;
+								continue;
+							}
+							// Vose's method
+							small.clear();
+							large.clear();
+							for (size_type i = 0; i < degree; ++i) {
+								probability[offset + i] = weight[offset + i] * (degree / total);
+								alias[offset + i] = i;
+								(probability[offset + i] < 1 ? small : large).push_back(i);
+							}
+							while (!small.empty() && !large.empty()) {
+								auto s = small.back(), l = large.back();
+								small.pop_back();
+								alias[offset + s] = l;
+								auto& pl = probability[offset + l];
+								pl -= 1 - probability[offset + s];
+								if (pl < 1) {
+									large.pop_back();
+									small.push_back(l);
+								}
+							}
+							// Whatever remains is only short of one by rounding
+							for (auto i : small)
+								probability[offset + i] = 1;
+							for (auto i : large)
+								probability[offset + i] = 1;
+						}
+					}
+				}
+				// @return The position of an entry of row `u`, which must not be empty.
+				size_type sample(size_type u, _splitmix64& r) const {
+					auto i = adj.offsets[u] + r.below(adj.degree(u));
+					return r.uniform() < probability[i] ? i : adj.offsets[u] + alias[i];
+				}
+			};
+
+			// Sorts each row of a compact adjacency by target, carrying along the weights, so adjacency can be tested by binary search.
+			template <class W>
+			void _sort_rows(compact_adjacency& adj, std::vector<W>& weight) {
+				using size_type = std::size_t;
+				const size_type n = adj.order();
+				#pragma omp parallel
+				{
+					std::vector<std::pair<size_type, W>> row;
+					#pragma omp for schedule(dynamic, 1024)
+					for (size_type u = 0; u < n; ++u) {
+						row.clear();
+						for (auto j = adj.offsets[u]; j < adj.offsets[u + 1]; ++j)
+							row.emplace_back(adj.targets[j], weight[j]);
+						std::sort(row.begin(), row.end(), [](const auto& l, const auto& r) { return l.first < r.first; });
+						for (size_type i = 0; i < row.size(); ++i) {
+							adj.targets[adj.offsets[u] + i] = row[i].first;
+							weight[adj.offsets[u] + i] = row[i].second;
+						}
+					}
+				}
+			}
+
+			// Runs `walks_per_vert` walks of `length` steps from every vertex in parallel, writing the vertices visited by walk `w` to `out[w * (length + 1)]` onwards.  Steps are biased as in node2vec by return parameter `p` and in-out parameter `q`, using rejection sampling against the first-order alias tables.
+			template <class Out>
+			void _random_walks(const compact_adjacency& adj, const _alias_tables& tables, std::uint64_t seed,
+				std::size_t walks_per_vert, std::size_t length, double p, double q, Out&& out) {
+				using size_type = std::size_t;
+				const size_type n = adj.order(), walks = n * walks_per_vert, none = n;
+				const bool first_order = p == 1 && q == 1;
+				const double max_bias = std::max({1 / p, 1.0, 1 / q});
+				auto adjacent = [&](size_type u, size_type v) {
+					return std::binary_search(adj.begin(u), adj.end(u), v);
+				};
+				#pragma omp parallel for schedule(dynamic, 64)
+				for (size_type w = 0; w < walks; ++w) {
+					auto r = _splitmix64::stream(seed, w);
+					auto u = w % n, previous = none;
+					const size_type base = w * (length + 1);
+					out(base, u);
+					for (size_type step = 1; step <= length && !tables.empty[u]; ++step) {
+						auto j = tables.sample(u, r);
+						while (!first_order && previous != none) {
+							auto x = adj.targets[j];
+							auto bias = x == previous ? 1 / p : adjacent(previous, x) ? 1.0 : 1 / q;
+							if (r.uniform() * max_bias < bias)
+								break;
+							j = tables.sample(u, r);
+						}
+						previous = u;
+						u = adj.targets[j];
+						out(base + step, u);
+					}
+				}
+			}
+
+			template <class G, class Weight, class Random>
+			auto _random_walks(const G& g, const Weight& weight, std::size_t walks_per_vert, std::size_t length,
+				Random& r, double p, double q) {
+				using size_type = std::size_t;
+				check_precondition(p > 0 && q > 0, "return and in-out parameters must be positive");
+				auto index = compact_index(g);
+				auto adj = _compact_adjacent_edges<traits::Out>(g, index);
+				std::vector<double> weights(adj.size());
+				for (size_type j = 0; j < adj.size(); ++j) {
+					weights[j] = weight(adj.edges[j]);
+					check_precondition(!(weights[j] < 0), "edges must have non-negative weights");
+				}
+				compact_adjacency rows{std::move(adj.offsets), std::move(adj.targets)};
+				_sort_rows(rows, weights);
+				_alias_tables tables(rows, weights);
+				auto seed = std::uniform_int_distribution<std::uint64_t>{}(r);
+				std::vector<typename compact_index<G>::Vert> walks(index.size() * walks_per_vert * (length + 1), traits::Verts<G>::null(g));
+				_random_walks(rows, tables, seed, walks_per_vert, length, p, q, [&](size_type i, size_type u) {
+					walks[i] = index[u];
+				});
+				return walks;
+			}
+		}
+		template <class Impl>
+		template <class Random>
+		auto Out_edge_graph<Impl>::random_walks(Order walks_per_vert, Order length, Random& r) const {
+			return impl::_random_walks(this->_impl(), [](const Edge&) { return 1.0; }, walks_per_vert, length, r, 1.0, 1.0);
+		}
+		template <class Impl>
+		template <class Weight, class Random>
+		auto Out_edge_graph<Impl>::random_walks(const Weight& weight, Order walks_per_vert, Order length, Random& r,
+			double p, double q) const {
+			return impl::_random_walks(this->_impl(), weight, walks_per_vert, length, r, p, q);
+		}
+	}
+}
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <tuple>
+#include <numeric>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+#include "impl/compact_adjacency.hpp"
+#include "impl/splitmix64.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			// Tarjan's algorithm, without recursion.
+			// @return The strongly connected component of each vertex and the number of components, which are numbered in topological order, so every edge between components leads to a higher number.
+			inline std::pair<std::vector<std::size_t>, std::size_t> _strong_components(const compact_adjacency& adj) {
+				using size_type = std::size_t;
+				const size_type n = adj.order(), none = n;
+				std::vector<size_type> number(n, none), low(n), component(n, none), stack;
+				// Each frame of the search is a vertex and the position of its next out-edge
+				std::vector<std::pair<size_type, size_type>> calls;
+				size_type counter = 0, count = 0;
+				auto visit = [&](size_type u) {
+					number[u] = low[u] = counter++;
+					stack.push_back(u);
+					calls.emplace_back(u, adj.offsets[u]);
+				};
+				for (size_type s = 0; s < n; ++s) {
+					if (number[s] != none)
+						continue;
+					visit(s);
+					while (!calls.empty()) {
+						auto [u, j] = calls.back();
+						if (j < adj.offsets[u + 1]) {
+							++calls.back().second;
+							auto v = adj.targets[j];
+							if (number[v] == none)
+								visit(v);
+							else if (component[v] == none)
+								low[u] = std::min(low[u], number[v]);
+							continue;
+						}
+						calls.pop_back();
+						if (!calls.empty()) {
+							auto p = calls.back().first;
+							low[p] = std::min(low[p], low[u]);
+						}
+						if (low[u] == number[u]) {
+							size_type v;
+							do {
+								v = stack.back();
+								stack.pop_back();
+								component[v] = count;
+							} while (v != u);
+							++count;
+						}
+					}
+				}
+				// Tarjan's algorithm completes components in reverse topological order
+				for (auto& c : component)
+					c = count - 1 - c;
+				return {std::move(component), count};
+			}
+
+			// @return The directed acyclic graph of edges between distinct components, without parallel edges.  Each row is sorted.
+			inline compact_adjacency _condensation(const compact_adjacency& adj, const std::vector<std::size_t>& component, std::size_t count) {
+				using size_type = std::size_t;
+				std::vector<size_type> keys, cokeys;
+				for (size_type u = 0; u < adj.order(); ++u) {
+					for (auto v = adj.begin(u); v != adj.end(u); ++v) {
+						if (component[u] != component[*v]) {
+							keys.push_back(component[u]);
+							cokeys.push_back(component[*v]);
+						}
+					}
+				}
+				auto [offsets, order] = _counting_sort(keys, count);
+				compact_adjacency result;
+				result.offsets.assign(count + 1, 0);
+				for (size_type c = 0; c < count; ++c) {
+					auto first = result.targets.size();
+					for (auto i = offsets[c]; i < offsets[c + 1]; ++i)
+						result.targets.push_back(cokeys[order[i]]);
+					std::sort(result.targets.begin() + first, result.targets.end());
+					result.targets.erase(std::unique(result.targets.begin() + first, result.targets.end()), result.targets.end());
+					result.offsets[c + 1] = result.targets.size();
+				}
+				return result;
+			}
+		}
+
+		/* Index over a graph which answers whether one vertex can reach another, usually in constant time.  Instances should be constructed by calling <Out_edge_graph::reachability_index>.
+		 *
+		 * Vertices are first condensed into their strongly connected components, numbered in topological order, so a component can only reach components numbered after it.  Following Yildirim et al.'s GRAIL, each of several randomized depth-first traversals labels each component with an interval containing the intervals of all components it reaches.  Following the bit-parallel labels of Yano et al., a few 64-bit words per component record which of the best-connected "hub" components reach it and which it reaches.  A query only searches the condensation, pruned by the same tests, when none of them decide it.  The index does not follow later changes to the graph.
+		 */
+		template <class G>
+		class Reachability_index {
+			using size_type = std::size_t;
+			using word = std::uint64_t;
+		public:
+			using Vert = typename G::Vert;
+			using Component_map = typename G::template Vert_map<size_type>;
+
+			Reachability_index(Component_map component, impl::compact_adjacency dag, size_type traversals, size_type chunks) :
+				_component(std::move(component)), _dag(std::move(dag)), _traversals(traversals), _chunks(chunks),
+				_pool(std::make_unique<_workspace_pool>()) {
+				_label();
+				_hubs();
+			}
+
+			// @return The number of strongly connected components.
+			size_type components() const {
+				return _dag.order();
+			}
+			// @return The strongly connected component of `v`, numbered in topological order.
+			size_type component(const Vert& v) const {
+				return _component(v);
+			}
+			// @return Whether there is a path from `u` to `v`.  Queries may be made concurrently.
+			bool reaches(const Vert& u, const Vert& v) const {
+				const size_type c = _component(u), d = _component(v);
+				auto decided = _decide(c, d);
+				if (decided != _unknown)
+					return decided == _yes;
+				_workspace_lease lease(*_pool, components());
+				auto& w = *lease.workspace;
+				// A fresh generation unmarks every component at once
+				if (!++w.generation) {
+					std::fill(w.seen.begin(), w.seen.end(), 0);
+					w.generation = 1;
+				}
+				const auto generation = w.generation;
+				auto& stack = w.stack;
+				stack.assign(1, c);
+				w.seen[c] = generation;
+				while (!stack.empty()) {
+					auto x = stack.back();
+					stack.pop_back();
+					for (auto y = _dag.begin(x); y != _dag.end(x); ++y) {
+						if (std::exchange(w.seen[*y], generation) == generation)
+							continue;
+						decided = _decide(*y, d);
+						if (decided == _yes)
+							return true;
+						if (decided == _unknown)
+							stack.push_back(*y);
+					}
+				}
+				return false;
+			}
+
+		private:
+			enum _answer { _no, _yes, _unknown };
+
+			// Scratch space for one search.  A component is marked when its entry in `seen` is the current generation.
+			struct _search_workspace {
+				std::vector<std::uint32_t> seen;
+				std::vector<size_type> stack;
+				std::uint32_t generation = 0;
+			};
+			// Workspaces not in use by a query, which are released with the index.
+			struct _workspace_pool {
+				std::mutex mutex;
+				std::vector<std::unique_ptr<_search_workspace>> free;
+			};
+			// Borrows a workspace from the pool, or makes one if every workspace is in use, for the lifetime of a query.
+			struct _workspace_lease {
+				_workspace_lease(_workspace_pool& pool, size_type components) :
+					pool(pool) {
+					{
+						std::lock_guard<std::mutex> lock(pool.mutex);
+						if (!pool.free.empty()) {
+							workspace = std::move(pool.free.back());
+							pool.free.pop_back();
+						}
+					}
+					if (!workspace) {
+						workspace = std::make_unique<_search_workspace>();
+						workspace->seen.assign(components, 0);
+					}
+				}
+				~_workspace_lease() {
+					std::lock_guard<std::mutex> lock(pool.mutex);
+					pool.free.push_back(std::move(workspace));
+				}
+				_workspace_pool& pool;
+				std::unique_ptr<_search_workspace> workspace;
+			};
+
+			_answer _decide(size_type c, size_type d) const {
+				if (c == d)
+					return _yes;
+				if (c > d)
+					return _no;
+				for (size_type t = 0; t < _traversals; ++t) {
+					auto [cl, cp] = _intervals[c * _traversals + t];
+					auto [dl, dp] = _intervals[d * _traversals + t];
+					if (dl < cl || dp > cp)
+						return _no;
+				}
+				for (size_type w = 0; w < _chunks; ++w) {
+					auto c_out = _out_bits[c * _chunks + w], d_out = _out_bits[d * _chunks + w];
+					auto c_in = _in_bits[c * _chunks + w], d_in = _in_bits[d * _chunks + w];
+					// A hub reached from `c` which reaches `d`
+					if (c_out & d_in)
+						return _yes;
+					// A hub reaching `c` but not `d`, or reached from `d` but not from `c`
+					if ((c_in & ~d_in) || (d_out & ~c_out))
+						return _no;
+				}
+				return _unknown;
+			}
+
+			// Labels each component, for each traversal, with the least and greatest post-order numbers among the components it reaches.
+			void _label() {
+				const size_type n = _dag.order();
+				_intervals.resize(n * _traversals);
+				std::vector<size_type> roots, post(n);
+				std::vector<char> is_target(n, false), visited(n);
+				for (auto c : _dag.targets)
+					is_target[c] = true;
+				for (size_type c = 0; c < n; ++c)
+					if (!is_target[c])
+						roots.push_back(c);
+				// Each frame is a component, the number of its children visited, and the child to visit first
+				std::vector<std::tuple<size_type, size_type, size_type>> calls;
+				for (size_type t = 0; t < _traversals; ++t) {
+					auto r = impl::_splitmix64::stream(0, t);
+					for (auto i = roots.size(); i > 1; --i)
+						std::swap(roots[i - 1], roots[r.below(i)]);
+					std::fill(visited.begin(), visited.end(), false);
+					size_type counter = 0;
+					auto visit = [&](size_type c) {
+						visited[c] = true;
+						calls.emplace_back(c, 0, _dag.degree(c) ? r.below(_dag.degree(c)) : 0);
+					};
+					for (auto s : roots) {
+						visit(s);
+						while (!calls.empty()) {
+							auto& [c, i, first] = calls.back();
+							if (i < _dag.degree(c)) {
+								auto d = _dag.targets[_dag.offsets[c] + (first + i++) % _dag.degree(c)];
+								if (!visited[d])
+									visit(d);
+								continue;
+							}
+							post[c] = counter++;
+							calls.pop_back();
+						}
+					}
+					// Every edge leads to a component numbered, and so labelled, later
+					for (auto c = n; c-- > 0;) {
+						auto low = post[c];
+						for (auto d = _dag.begin(c); d != _dag.end(c); ++d)
+							low = std::min(low, _intervals[*d * _traversals + t].first);
+						_intervals[c * _traversals + t] = {low, post[c]};
+					}
+				}
+			}
+
+			// Chooses the components with most edges in the condensation as hubs, and records which hubs reach and are reached from each component.
+			void _hubs() {
+				const size_type n = _dag.order(), hubs = std::min(n, 64 * _chunks);
+				_out_bits.assign(n * _chunks, 0);
+				_in_bits.assign(n * _chunks, 0);
+				if (!hubs)
+					return;
+				std::vector<size_type> degree(n), order(n);
+				for (size_type c = 0; c < n; ++c) {
+					degree[c] += _dag.degree(c);
+					for (auto d = _dag.begin(c); d != _dag.end(c); ++d)
+						++degree[*d];
+				}
+				std::iota(order.begin(), order.end(), 0);
+				std::partial_sort(order.begin(), order.begin() + hubs, order.end(), [&](size_type l, size_type r) {
+					return degree[l] > degree[r] || (degree[l] == degree[r] && l < r);
+				});
+				for (size_type h = 0; h < hubs; ++h) {
+					auto bit = word{1} << (h % 64);
+					_out_bits[order[h] * _chunks + h / 64] |= bit;
+					_in_bits[order[h] * _chunks + h / 64] |= bit;
+				}
+				for (auto c = n; c-- > 0;)
+					for (auto d = _dag.begin(c); d != _dag.end(c); ++d)
+						for (size_type w = 0; w < _chunks; ++w)
+							_out_bits[c * _chunks + w] |= _out_bits[*d * _chunks + w];
+				for (size_type c = 0; c < n; ++c)
+					for (auto d = _dag.begin(c); d != _dag.end(c); ++d)
+						for (size_type w = 0; w < _chunks; ++w)
+							_in_bits[*d * _chunks + w] |= _in_bits[c * _chunks + w];
+			}
+
+			Component_map _component;
+			impl::compact_adjacency _dag;
+			size_type _traversals, _chunks;
+			std::vector<std::pair<size_type, size_type>> _intervals;
+			std::vector<word> _out_bits, _in_bits;
+			std::unique_ptr<_workspace_pool> _pool;
+		};
+
+		template <class Impl>
+		auto Out_edge_graph<Impl>::reachability_index(std::size_t traversals, std::size_t chunks) const {
+			auto index = impl::compact_index(this->_impl());
+			auto adj = impl::_compact_adjacent_edges<impl::traits::Out>(this->_impl(), index);
+			auto [component, count] = impl::_strong_components(adj);
+			auto dag = impl::_condensation(adj, component, count);
+			auto component_map = this->vert_map(std::size_t{});
+			for (std::size_t u = 0; u < index.size(); ++u)
+				component_map[index[u]] = component[u];
+			return Reachability_index<Out_edge_graph>(std::move(component_map), std::move(dag), traversals, chunks);
+		}
+	}
+}
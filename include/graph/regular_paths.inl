@@ -0,0 +1,135 @@
+#pragma once
+
+#include <limits>
+#include <functional>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include <range/v3/view/filter.hpp>
+#include <range/v3/view/join.hpp>
+#include <range/v3/view/transform.hpp>
+#include <range/v3/distance.hpp>
+
+#include "impl/exceptions.hpp"
+#include "impl/Tensor_product.hpp"
+#include "impl/Subforest.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		/* Finite automaton over edge labels, whose states are the vertices of the out-edge graph `states` and whose transitions are its edges, each labelled `symbol(t)`.  Transitions from a state may share a label, so the automaton may be nondeterministic, but there are no empty transitions.  Instances should be constructed by calling <automaton>, and refer to `states` but hold copies of `accepting` and `symbol`, so large maps should be passed through `std::cref`.
+		 */
+		template <class A, class Accepting, class Symbol>
+		struct Automaton {
+			const A& states;
+			Vert<A> start;
+			Accepting accepting;
+			Symbol symbol;
+		};
+
+		// Constructs the <Automaton> with the given states and transitions which starts at `start` and accepts in the states `q` for which `accepting(q)`.
+		template <class A, class Accepting, class Symbol>
+		Automaton<A, Accepting, Symbol> automaton(const A& states, Vert<A> start, Accepting accepting, Symbol symbol) {
+			return {states, std::move(start), std::move(accepting), std::move(symbol)};
+		}
+
+		namespace impl {
+			/* Tensor product of a graph with the transitions of an automaton, restricted to pairs of an edge and a transition with equal labels.  Its out-edges are found only as they are needed, so a search from one pair never touches pairs it cannot reach, and it shares the dense maps of <Tensor_product> when both factors have contiguous handles.
+			 */
+			template <class G, class A, class Label, class Symbol>
+			class Automaton_product : public Tensor_product<G, A> {
+				using _base_type = Tensor_product<G, A>;
+				const Label *_label = nullptr;
+				const Symbol *_symbol = nullptr;
+			public:
+				using Vert = typename _base_type::Vert;
+				using Edge = typename _base_type::Edge;
+				using Size = typename _base_type::Size;
+				using Out_degree = Size;
+				Automaton_product() = default;
+				Automaton_product(G g, A a, const Label& label, const Symbol& symbol) :
+					_base_type(std::move(g), std::move(a)), _label(&label), _symbol(&symbol) {
+				}
+				auto out_edges(const Vert& v) const {
+					const auto& g = std::get<0>(this->_factors());
+					const auto& a = std::get<1>(this->_factors());
+					auto q = std::get<1>(v._tuple);
+					return traits::Out_edges<G>::range(g, std::get<0>(v._tuple)) |
+						ranges::view::transform([this, a, q](const auto& e) {
+							return traits::Out_edges<A>::range(a, q) |
+								ranges::view::filter([this, l = (*_label)(e)](const auto& t) { return (*_symbol)(t) == l; }) |
+								ranges::view::transform([e](const auto& t) { return Edge(tuple_t<std::decay_t<decltype(e)>, std::decay_t<decltype(t)>>(e, t)); });
+						}) |
+						ranges::view::join;
+				}
+				Out_degree out_degree(const Vert& v) const {
+					return static_cast<Out_degree>(ranges::distance(out_edges(v)));
+				}
+			};
+
+			template <class G, class Automaton, class Label>
+			auto _automaton_product(const G& g, const Automaton& automaton, const Label& label) {
+				using A = std::decay_t<decltype(automaton.states._impl())>;
+				using Symbol = std::decay_t<decltype(automaton.symbol)>;
+				return Automaton_product<const G *, const A *, Label, Symbol>(&g, &automaton.states._impl(), label, automaton.symbol);
+			}
+		}
+
+		template <class Impl>
+		template <class Automaton, class Label>
+		auto Out_edge_graph<Impl>::regular_path_query(const Vert& s, const Automaton& automaton, const Label& label) const {
+			auto product = impl::_automaton_product(this->_impl(), automaton, label);
+			using Pair = typename decltype(product)::Vert;
+			auto visited = product.ephemeral_vert_set();
+			auto matched = this->ephemeral_vert_set();
+			std::vector<Vert> result;
+			// Every pair visited, in breadth-first order
+			std::vector<Pair> queue{Pair(impl::tuple_t<Vert, std::decay_t<decltype(automaton.start)>>(s, automaton.start))};
+			visited.insert(queue.front());
+			for (std::size_t i = 0; i < queue.size(); ++i) {
+				auto x = queue[i];
+				const auto& v = std::get<0>(x._tuple);
+				if (automaton.accepting(std::get<1>(x._tuple)) && matched.insert(v))
+					result.push_back(v);
+				for (auto e : product.out_edges(x)) {
+					auto y = product.head(e);
+					if (visited.insert(y))
+						queue.push_back(y);
+				}
+			}
+			return result;
+		}
+
+		template <class Impl>
+		template <class Automaton, class Label, class Weight, class Compare, class Combine>
+		auto Out_edge_graph<Impl>::regular_shortest_path(const Vert& s, const Vert& t, const Automaton& automaton, const Label& label, const Weight& weight,
+			const Compare& compare, const Combine& combine) const {
+			// TODO: Convert these to parameters
+			using D = std::decay_t<std::result_of_t<const Weight&(Edge)>>;
+			auto zero = D{}, inf = std::numeric_limits<D>::max();
+
+			auto product = impl::_automaton_product(this->_impl(), automaton, label);
+			using Pair = typename decltype(product)::Vert;
+			auto source = Pair(impl::tuple_t<Vert, std::decay_t<decltype(automaton.start)>>(s, automaton.start));
+			// The search stops at the first accepting pair of `t` to be settled
+			bool found = false;
+			auto target = source;
+			auto [tree, distance] = impl::_dijkstra<impl::traits::Out>(product, source,
+				[&weight](const auto& e) { return weight(std::get<0>(e._tuple)); },
+				compare, combine, zero, inf,
+				[&](const Pair& x) {
+					found = std::get<0>(x._tuple) == t && automaton.accepting(std::get<1>(x._tuple));
+					if (found)
+						target = x;
+					return found;
+				});
+			if (!found)
+				return this->null_path();
+			std::vector<Edge> edges;
+			for (auto e = tree.in_edge_or_null(target); e != product.null_edge(); e = tree.in_edge_or_null(product.tail(e)))
+				edges.push_back(std::get<0>(e._tuple));
+			std::reverse(edges.begin(), edges.end());
+			return this->path(s, std::move(edges));
+		}
+	}
+}
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <tuple>
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+
+#include "impl/compact_adjacency.hpp"
+#include "impl/parallel_sort.hpp"
+#include "impl/Stable_adjacency_list.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			// @return The vertices in the order they are visited by breadth-first searches which visit neighbors in the order given by `by`.  Each vertex `i` in turn may start a search from `start(i, visited)`, which returns the index of the vertex to start from, or `adj.order()`, standing for no vertex, to skip `i`.
+			template <class Start, class Less>
+			std::vector<std::size_t> _breadth_first_order(const compact_adjacency& adj, const Start& start, const Less& by) {
+				using size_type = std::size_t;
+				const size_type n = adj.order();
+				std::vector<size_type> order, neighbors;
+				std::vector<char> visited(n, false);
+				order.reserve(n);
+				for (size_type i = 0; i < n; ++i) {
+					auto s = start(i, visited);
+					if (s == n)
+						continue;
+					visited[s] = true;
+					auto first = order.size();
+					order.push_back(s);
+					for (auto j = first; j < order.size(); ++j) {
+						auto u = order[j];
+						neighbors.clear();
+						for (auto v = adj.begin(u); v != adj.end(u); ++v)
+							if (!visited[*v])
+								visited[*v] = true, neighbors.push_back(*v);
+						std::sort(neighbors.begin(), neighbors.end(), by);
+						order.insert(order.end(), neighbors.begin(), neighbors.end());
+					}
+				}
+				return order;
+			}
+
+			// Finds a pseudo-peripheral vertex of the component of `s` by the heuristic of George and Liu: repeatedly move to a vertex of least degree in the last level of a breadth-first search while its eccentricity grows.
+			inline std::size_t _pseudo_peripheral(const compact_adjacency& adj, std::size_t s, std::vector<std::size_t>& level) {
+				using size_type = std::size_t;
+				const size_type none = adj.order();
+				size_type eccentricity = 0;
+				std::vector<size_type> queue;
+				for (;;) {
+					queue.assign(1, s);
+					level[s] = 0;
+					for (size_type i = 0; i < queue.size(); ++i)
+						for (auto v = adj.begin(queue[i]); v != adj.end(queue[i]); ++v)
+							if (level[*v] == none)
+								level[*v] = level[queue[i]] + 1, queue.push_back(*v);
+					auto last = level[queue.back()], next = queue.back();
+					for (auto u : queue) {
+						if (level[u] == last && adj.degree(u) < adj.degree(next))
+							next = u;
+						level[u] = none;
+					}
+					if (last <= eccentricity)
+						return s;
+					eccentricity = last;
+					s = next;
+				}
+			}
+
+			// Reverse Cuthill–McKee: breadth-first searches from pseudo-peripheral vertices, visiting neighbors by increasing degree, reversed.
+			inline std::vector<std::size_t> _reverse_cuthill_mckee(const compact_adjacency& adj) {
+				using size_type = std::size_t;
+				const size_type n = adj.order();
+				std::vector<size_type> level(n, n);
+				auto by_degree = [&](size_type l, size_type r) {
+					return adj.degree(l) < adj.degree(r) || (adj.degree(l) == adj.degree(r) && l < r);
+				};
+				auto order = _breadth_first_order(adj, [&](size_type i, const std::vector<char>& visited) {
+					return visited[i] ? n : _pseudo_peripheral(adj, i, level);
+				}, by_degree);
+				std::reverse(order.begin(), order.end());
+				return order;
+			}
+
+			// Gorder, after Wei et al.: greedily places next the vertex with the most neighbors and common neighbors among the last `window` placed vertices.  Scores are kept in a lazy max-heap, and as in the original, common neighbors through vertices of degree above the square root of the order are ignored.
+			inline std::vector<std::size_t> _gorder(const compact_adjacency& adj, std::size_t window) {
+				using size_type = std::size_t;
+				const size_type n = adj.order();
+				const auto hub = static_cast<size_type>(std::sqrt(static_cast<double>(n))) + 1;
+				std::vector<size_type> score(n, 0), order, by_degree(n);
+				std::vector<char> placed(n, false);
+				std::priority_queue<std::pair<size_type, size_type>> heap;
+				// Breaks ties towards the lower index
+				auto push = [&](size_type u) {
+					if (!placed[u])
+						heap.emplace(score[u], n - 1 - u);
+				};
+				auto update = [&](size_type u, bool entering) {
+					auto change = [&](size_type v) {
+						entering ? ++score[v] : --score[v];
+						push(v);
+					};
+					for (auto x = adj.begin(u); x != adj.end(u); ++x) {
+						change(*x);
+						if (adj.degree(*x) <= hub)
+							for (auto y = adj.begin(*x); y != adj.end(*x); ++y)
+								if (*y != u)
+									change(*y);
+					}
+				};
+				std::iota(by_degree.begin(), by_degree.end(), 0);
+				_parallel_sort(by_degree, [&](size_type l, size_type r) {
+					return adj.degree(l) > adj.degree(r) || (adj.degree(l) == adj.degree(r) && l < r);
+				});
+				order.reserve(n);
+				for (size_type next = 0; order.size() < n;) {
+					size_type u = n;
+					while (!heap.empty()) {
+						auto [s, key] = heap.top();
+						heap.pop();
+						auto v = n - 1 - key;
+						if (!placed[v] && score[v] == s && s > 0) {
+							u = v;
+							break;
+						}
+					}
+					if (u == n) {
+						// Nothing in the window is related to an unplaced vertex, so start afresh from the largest remaining degree
+						while (placed[by_degree[next]])
+							++next;
+						u = by_degree[next];
+					}
+					placed[u] = true;
+					order.push_back(u);
+					update(u, true);
+					if (order.size() > window)
+						update(order[order.size() - 1 - window], false);
+				}
+				return order;
+			}
+
+			// Stable graph with the same kinds of adjacency as `G`, into which it may be copied.
+			template <class G>
+			using _stable_copy_type =
+				std::conditional_t<traits::has_out_edges<G> && traits::has_in_edges<G>, Stable_bi_adjacency_list<>,
+				std::conditional_t<traits::has_out_edges<G>, Stable_out_adjacency_list<>,
+				std::conditional_t<traits::has_in_edges<G>, Stable_in_adjacency_list<>,
+				Stable_edge_list<>>>>;
+		}
+		template <class Impl>
+		auto Graph<Impl>::reorder(Reorder_policy policy) const {
+			using size_type = std::size_t;
+			const auto& g = this->_impl();
+			auto index = impl::compact_index(g);
+			auto adj = impl::_compact_neighbors(g, index);
+			const size_type n = index.size();
+			std::vector<size_type> order;
+			switch (policy) {
+			case Reorder_policy::reverse_cuthill_mckee:
+				order = impl::_reverse_cuthill_mckee(adj);
+				break;
+			case Reorder_policy::descending_degree:
+				order.resize(n);
+				std::iota(order.begin(), order.end(), 0);
+				impl::_parallel_sort(order, [&](size_type l, size_type r) {
+					return adj.degree(l) > adj.degree(r) || (adj.degree(l) == adj.degree(r) && l < r);
+				});
+				break;
+			case Reorder_policy::breadth_first:
+				order = impl::_breadth_first_order(adj, [&](size_type i, const std::vector<char>& visited) {
+					return visited[i] ? n : i;
+				}, std::less<>{});
+				break;
+			case Reorder_policy::gorder:
+				order = impl::_gorder(adj, 5);
+				break;
+			}
+
+			// Materialize the relabelled graph with the same kinds of adjacency, inserting edges grouped by their new tails
+			auto result = _wrap_graph(impl::_stable_copy_type<Impl>{});
+			using New_vert = typename decltype(result)::Vert;
+			std::vector<New_vert> new_verts(n);
+			std::vector<size_type> rank(n);
+			for (size_type i = 0; i < n; ++i) {
+				new_verts[i] = result.insert_vert();
+				rank[order[i]] = i;
+			}
+			auto old_to_new = vert_map(result.null_vert());
+			auto new_to_old = result.vert_map(null_vert());
+			for (size_type i = 0; i < n; ++i) {
+				old_to_new[index[order[i]]] = new_verts[i];
+				new_to_old[new_verts[i]] = index[order[i]];
+			}
+			std::vector<Edge> edges;
+			std::vector<size_type> keys;
+			edges.reserve(size());
+			keys.reserve(size());
+			for (auto e : this->edges()) {
+				keys.push_back(rank[index(tail(e))]);
+				edges.push_back(std::move(e));
+			}
+			auto [offsets, sorted] = impl::_counting_sort(keys, n);
+			auto old_edge = result.edge_map(null_edge());
+			for (auto j : sorted) {
+				const auto& e = edges[j];
+				auto f = result.insert_edge(new_verts[keys[j]], new_verts[rank[index(head(e))]]);
+				old_edge[f] = e;
+			}
+			return std::make_tuple(std::move(result), std::move(old_to_new), std::move(new_to_old), std::move(old_edge));
+		}
+
+		template <class Impl>
+		auto Graph<Impl>::materialize() const {
+			using size_type = std::size_t;
+			const auto& g = this->_impl();
+			auto index = impl::compact_index(g);
+			const size_type n = index.size();
+			// Edges are gathered in parallel, grouped by tail, or by head if there are only in-edges, so each is only visited once
+			constexpr bool
+				out = impl::traits::has_out_edges<Impl>,
+				in = impl::traits::has_in_edges<Impl>;
+			auto adj = [&] {
+				if constexpr (out)
+					return impl::_compact_adjacent_edges<impl::traits::Out>(g, index);
+				else if constexpr (in)
+					return impl::_compact_adjacent_edges<impl::traits::In>(g, index);
+				else
+					return impl::_compact_edges<impl::traits::Out>(g, index);
+			}();
+			auto result = _wrap_graph(impl::_stable_copy_type<Impl>{});
+			using New_vert = typename decltype(result)::Vert;
+			std::vector<New_vert> new_verts(n);
+			auto old_to_new = vert_map(result.null_vert());
+			auto new_to_old = result.vert_map(null_vert());
+			for (size_type i = 0; i < n; ++i) {
+				new_verts[i] = result.insert_vert();
+				old_to_new[index[i]] = new_verts[i];
+				new_to_old[new_verts[i]] = index[i];
+			}
+			auto old_edge = result.edge_map(null_edge());
+			for (size_type u = 0; u < n; ++u) {
+				for (auto j = adj.offsets[u]; j < adj.offsets[u + 1]; ++j) {
+					auto s = new_verts[u], t = new_verts[adj.targets[j]];
+					if constexpr (!out && in)
+						std::swap(s, t);
+					old_edge[result.insert_edge(s, t)] = adj.edges[j];
+				}
+			}
+			return std::make_tuple(std::move(result), std::move(old_to_new), std::move(new_to_old), std::move(old_edge));
+		}
+	}
+}
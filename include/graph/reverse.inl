@@ -1,6 +1,7 @@
 #pragma once
 
 #include "impl/Reverse.hpp"
+#include "impl/Transpose_index.hpp"
 
 namespace graph {
 	inline namespace v1 {
@@ -8,5 +9,10 @@ namespace graph {
 		auto Graph<Impl>::reverse_view() const {
 			return _wrap_graph(impl::Reverse(&this->_impl()));
 		}
+
+		template <class Impl>
+		auto Out_edge_graph<Impl>::bi_edge_view() const {
+			return _wrap_graph(impl::With_transpose(&this->_impl()));
+		}
 	}
 }
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <numeric>
+#include <limits>
+#include <type_traits>
+
+#include "impl/omp.hpp"
+#include "impl/compact_adjacency.hpp"
+#include "impl/union_find.hpp"
+#include "impl/parallel_sort.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			// Borůvka's algorithm on edges `[0, m)` between `tail` and `head`.  Each round, every component selects its lightest incident edge in parallel, and the selected edges are merged through a lock-free union-find.  Ties are broken by edge position, so the selected edges never form a cycle.
+			// @return Whether each edge is in the minimum spanning forest.
+			template <class W, class Compare>
+			std::vector<char> _boruvka(std::size_t n, const std::vector<std::size_t>& tail, const std::vector<std::size_t>& head,
+				const std::vector<W>& weight, const Compare& compare) {
+				using size_type = std::size_t;
+				const size_type m = tail.size(), none = std::numeric_limits<size_type>::max();
+				auto lighter = [&](size_type a, size_type b) {
+					return compare(weight[a], weight[b]) || (!compare(weight[b], weight[a]) && a < b);
+				};
+				concurrent_union_find components(n);
+				std::vector<std::atomic<size_type>> lightest(n);
+				std::vector<char> selected(m, false);
+				std::vector<size_type> active(m), next;
+				std::iota(active.begin(), active.end(), 0);
+				std::vector<size_type> counts;
+				while (!active.empty()) {
+					#pragma omp parallel for
+					for (size_type u = 0; u < n; ++u)
+						lightest[u].store(none, std::memory_order_relaxed);
+					// Select the lightest edge leaving each component, and drop edges which no longer leave one
+					next.resize(active.size());
+					#pragma omp parallel
+					{
+						const size_type t = omp_get_thread_num(), threads = omp_get_num_threads();
+						#pragma omp single
+						counts.assign(threads + 1, 0);
+						const size_type begin = active.size() * t / threads, end = active.size() * (t + 1) / threads;
+						size_type kept = begin;
+						for (size_type i = begin; i < end; ++i) {
+							auto j = active[i];
+							auto u = components.find(tail[j]), v = components.find(head[j]);
+							if (u == v)
+								continue;
+							next[kept++] = j;
+							for (auto r : {u, v}) {
+								auto current = lightest[r].load(std::memory_order_relaxed);
+								while ((current == none || lighter(j, current)) &&
+									!lightest[r].compare_exchange_weak(current, j, std::memory_order_relaxed));
+							}
+						}
+						counts[t + 1] = kept - begin;
+						#pragma omp barrier
+						#pragma omp single
+						std::partial_sum(counts.begin(), counts.end(), counts.begin());
+						std::move(next.begin() + begin, next.begin() + kept, active.begin() + counts[t]);
+					}
+					active.resize(counts.back());
+					// Merge each component along its selected edge, which joins two components exactly once
+					#pragma omp parallel for
+					for (size_type u = 0; u < n; ++u) {
+						auto j = lightest[u].load(std::memory_order_relaxed);
+						if (j != none && components.unite(tail[j], head[j]))
+							selected[j] = true;
+					}
+				}
+				return selected;
+			}
+		}
+		template <class Impl>
+		template <class Weight, class Compare>
+		auto Graph<Impl>::minimum_spanning_forest(const Weight& weight, const Compare& compare) const {
+			using W = std::decay_t<std::result_of_t<const Weight&(Edge)>>;
+			using size_type = std::size_t;
+			const auto& g = this->_impl();
+			auto index = impl::compact_index(g);
+			const size_type n = index.size();
+			std::vector<std::pair<W, Edge>> edges;
+			edges.reserve(size());
+			for (auto e : this->edges())
+				if (tail(e) != head(e))
+					edges.emplace_back(weight(e), std::move(e));
+			impl::_parallel_sort(edges, [&](const auto& l, const auto& r) {
+				return compare(l.first, r.first);
+			});
+			// Kruskal's algorithm, which can stop once the forest is a spanning tree
+			auto forest = edge_set();
+			impl::union_find components(n);
+			size_type accepted = 0;
+			for (size_type i = 0; i < edges.size() && accepted + 1 < n; ++i) {
+				const auto& e = edges[i].second;
+				if (components.unite(index(tail(e)), index(head(e)))) {
+					forest.insert(e);
+					++accepted;
+				}
+			}
+			return forest;
+		}
+		template <class Impl>
+		template <class Weight, class Compare>
+		auto Out_edge_graph<Impl>::minimum_spanning_forest(const Weight& weight, const Compare& compare) const {
+			using W = std::decay_t<std::result_of_t<const Weight&(Edge)>>;
+			using size_type = std::size_t;
+			const auto& g = this->_impl();
+			auto index = impl::compact_index(g);
+			auto adj = impl::_compact_adjacent_edges<impl::traits::Out>(g, index);
+			const size_type n = index.size(), m = adj.size();
+			std::vector<size_type> tail(m);
+			std::vector<W> weights(m);
+			#pragma omp parallel for schedule(dynamic, 1024)
+			for (size_type u = 0; u < n; ++u)
+				for (auto j = adj.offsets[u]; j < adj.offsets[u + 1]; ++j)
+					tail[j] = u;
+			for (size_type j = 0; j < m; ++j)
+				weights[j] = weight(adj.edges[j]);
+			auto selected = impl::_boruvka(n, tail, adj.targets, weights, compare);
+			auto forest = this->edge_set();
+			for (size_type j = 0; j < m; ++j)
+				if (selected[j])
+					forest.insert(adj.edges[j]);
+			return forest;
+		}
+	}
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <vector>
+#include <numeric>
+
+#include "impl/omp.hpp"
+#include "impl/compact_adjacency.hpp"
+
+namespace graph {
+	inline namespace v1 {
+		namespace impl {
+			// Keeps only the neighbors ranked above each vertex, where vertices are ranked by degree and then by index.  This orients every undirected edge exactly once and bounds each remaining degree by O(sqrt(m)).
+			inline compact_adjacency _orient_by_degree(const compact_adjacency& adj) {
+				using size_type = compact_adjacency::size_type;
+				const size_type n = adj.order();
+				auto ranked_below = [&](size_type u, size_type v) {
+					auto du = adj.degree(u), dv = adj.degree(v);
+					return du < dv || (du == dv && u < v);
+				};
+				compact_adjacency result;
+				result.offsets.assign(n + 1, 0);
+				#pragma omp parallel for schedule(dynamic, 1024)
+				for (size_type u = 0; u < n; ++u)
+					result.offsets[u + 1] = std::count_if(adj.begin(u), adj.end(u),
+						[&](size_type v) { return ranked_below(u, v); });
+				std::partial_sum(result.offsets.begin(), result.offsets.end(), result.offsets.begin());
+				result.targets.resize(result.offsets[n]);
+				#pragma omp parallel for schedule(dynamic, 1024)
+				for (size_type u = 0; u < n; ++u)
+					std::copy_if(adj.begin(u), adj.end(u), result.targets.begin() + result.offsets[u],
+						[&](size_type v) { return ranked_below(u, v); });
+				return result;
+			}
+
+			// Above this out-degree, a vertex's neighbors are marked in a dense array and probed rather than merged.
+			constexpr std::size_t _triangle_probe_degree = 32;
+
+			// Counts the triangles of a degree-oriented graph, optionally accumulating the number incident to each vertex into `local`.
+			template <bool Local>
+			std::size_t _count_triangles(const compact_adjacency& forward, std::vector<std::size_t>& local) {
+				using size_type = compact_adjacency::size_type;
+				const size_type n = forward.order(), none = n;
+				size_type total = 0;
+				auto found = [&](size_type u, size_type v, size_type w) {
+					if constexpr (Local) {
+						#pragma omp atomic
+						++local[u];
+						#pragma omp atomic
+						++local[v];
+						#pragma omp atomic
+						++local[w];
+					}
+				};
+				#pragma omp parallel reduction(+:total)
+				{
+					std::vector<size_type> mark;
+					#pragma omp for schedule(dynamic, 64)
+					for (size_type u = 0; u < n; ++u) {
+						if (forward.degree(u) > _triangle_probe_degree) {
+							// Probe a dense marker array, which is stamped with `u` so it never needs clearing
+							if (mark.empty())
+								mark.assign(n, none);
+							for (auto v = forward.begin(u); v != forward.end(u); ++v)
+								mark[*v] = u;
+							for (auto v = forward.begin(u); v != forward.end(u); ++v)
+								for (auto w = forward.begin(*v); w != forward.end(*v); ++w)
+									if (mark[*w] == u) {
+										++total;
+										found(u, *v, *w);
+									}
+						} else {
+							// Merge the sorted neighbor lists
+							for (auto v = forward.begin(u); v != forward.end(u); ++v) {
+								auto i = forward.begin(u), i_end = forward.end(u);
+								auto j = forward.begin(*v), j_end = forward.end(*v);
+								while (i != i_end && j != j_end) {
+									if (*i < *j) {
+										++i;
+									} else if (*j < *i) {
+										++j;
+									} else {
+										++total;
+										found(u, *v, *i);
+										++i, ++j;
+									}
+								}
+							}
+						}
+					}
+				}
+				return total;
+			}
+		}
+		template <class Impl>
+		auto Graph<Impl>::count_triangles() const -> Size {
+			auto index = impl::compact_index(this->_impl());
+			auto forward = impl::_orient_by_degree(impl::_compact_neighbors(this->_impl(), index));
+			std::vector<std::size_t> unused;
+			return static_cast<Size>(impl::_count_triangles<false>(forward, unused));
+		}
+		template <class Impl>
+		auto Graph<Impl>::local_clustering() const {
+			auto index = impl::compact_index(this->_impl());
+			auto adj = impl::_compact_neighbors(this->_impl(), index);
+			std::vector<std::size_t> local(index.size(), 0);
+			impl::_count_triangles<true>(impl::_orient_by_degree(adj), local);
+			auto result = vert_map(0.0);
+			for (std::size_t u = 0; u < index.size(); ++u) {
+				if (auto d = adj.degree(u); d > 1)
+					result[index[u]] = 2.0 * local[u] / (static_cast<double>(d) * (d - 1));
+			}
+			return result;
+		}
+	}
+}
@@ -117,6 +117,47 @@ SCENARIO("out-adjacency lists behave properly", "[Out_adjacency_list]") {
 				REQUIRE((!tree.in_tree(g.tail(e)) || tree.in_tree(g.head(e))));
 			// TODO: Use the cut lemma to verify this tree has minimal weight
 		}
+		WHEN("searching for the minimum spanning forest") {
+			auto weight = g.edge_map(0.0);
+			for (auto e : g.edges())
+				weight[e] = std::uniform_real_distribution<double>{}(r);
+			auto forest = g.minimum_spanning_forest(weight);
+			require_minimum_spanning_forest(g, forest, weight);
+		}
+		WHEN("counting triangles") {
+			auto adjacent = [&](auto u, auto v) {
+				for (auto e : g.out_edges(u))
+					if (g.head(e) == v)
+						return true;
+				for (auto e : g.out_edges(v))
+					if (g.head(e) == u)
+						return true;
+				return false;
+			};
+			std::size_t expected = 0;
+			for (auto u : g.verts())
+				for (auto v : g.verts())
+					for (auto w : g.verts())
+						if (u != v && v != w && w != u && adjacent(u, v) && adjacent(v, w) && adjacent(w, u))
+							++expected;
+			REQUIRE(g.count_triangles() == expected / 6);
+			auto clustering = g.local_clustering();
+			for (auto v : g.verts())
+				REQUIRE((clustering(v) >= 0 && clustering(v) <= 1));
+		}
+		WHEN("sampling after erasing edges") {
+			std::vector<graph::Edge<G>> erased;
+			for (auto e : g.edges())
+				if (std::bernoulli_distribution{}(r))
+					erased.push_back(e);
+			for (auto e : erased)
+				gt.erase_edge(e);
+			// Every remaining edge is eventually sampled
+			auto seen = g.ephemeral_edge_set();
+			for (auto e : g.random_edges(r, 100 * g.size()))
+				seen.insert(e);
+			REQUIRE(seen.size() == g.size());
+		}
 	}
 }
 
@@ -1,10 +1,13 @@
 
 #include <graph/Atomic_adjacency_list.hpp>
+#include <graph/Stable_adjacency_list.hpp>
 
 #include "Graph_tester.hpp"
 
 #include <exception>
 #include <algorithm>
+#include <set>
+#include <cmath>
 
 #include <range/v3/distance.hpp>
 
@@ -334,6 +337,90 @@ SCENARIO("atomic in-adjacency lists behave properly", "[Atomic_in_adjacency_list
 	}
 }
 
+SCENARIO("random graphs are generated in parallel", "[Atomic_out_adjacency_list]") {
+	using G = graph::Atomic_out_adjacency_list;
+	using S = graph::Stable_out_adjacency_list;
+	// The parallel and serial generators must agree on the edges between the `i`th new vertices
+	auto endpoints = [](const auto& g) {
+		auto index = g.vert_map(std::size_t{});
+		std::size_t i = 0;
+		for (auto v : g.verts())
+			index[v] = i++;
+		std::multiset<std::pair<std::size_t, std::size_t>> result;
+		for (auto e : g.edges())
+			result.emplace(index(g.tail(e)), index(g.head(e)));
+		return result;
+	};
+	G g;
+	S s;
+	std::mt19937 r, rs;
+	WHEN("generating G(n, p)") {
+		const std::size_t n = 300;
+		const double p = 0.05;
+		graph::generate_gnp(g, n, p, r);
+		graph::generate_gnp(s, n, p, rs);
+		REQUIRE(g.order() == n);
+		auto edges = endpoints(g);
+		REQUIRE(edges == endpoints(s));
+		for (auto [u, v] : edges) {
+			REQUIRE(u != v);
+			REQUIRE(edges.count({u, v}) == 1);
+		}
+		// Within five standard deviations of the expectation
+		const double mean = p * n * (n - 1), deviation = std::sqrt(mean * (1 - p));
+		REQUIRE(std::abs(g.size() - mean) < 5 * deviation);
+	}
+	WHEN("generating G(n, m)") {
+		graph::generate_gnm(g, 100, 1000, r);
+		graph::generate_gnm(s, 100, 1000, rs);
+		REQUIRE(g.order() == 100);
+		REQUIRE(g.size() == 1000);
+		REQUIRE(endpoints(g) == endpoints(s));
+	}
+	WHEN("generating an R-MAT graph") {
+		graph::generate_rmat(g, 7, 1000, 0.57, 0.19, 0.19, r);
+		graph::generate_rmat(s, 7, 1000, 0.57, 0.19, 0.19, rs);
+		REQUIRE(g.order() == 128);
+		REQUIRE(g.size() == 1000);
+		REQUIRE(endpoints(g) == endpoints(s));
+	}
+	WHEN("generating a Barabási–Albert graph") {
+		graph::generate_barabasi_albert(g, 200, 3, r);
+		graph::generate_barabasi_albert(s, 200, 3, rs);
+		REQUIRE(g.order() == 200);
+		REQUIRE(g.size() == 600);
+		auto edges = endpoints(g);
+		REQUIRE(edges == endpoints(s));
+		for (auto [u, v] : edges)
+			REQUIRE(v <= u);
+	}
+	WHEN("generating a random geometric graph") {
+		const std::size_t n = 300;
+		const double radius = 0.1;
+		auto position = graph::generate_random_geometric(g, n, radius, r);
+		graph::generate_random_geometric(s, n, radius, rs);
+		REQUIRE(g.order() == n);
+		REQUIRE(endpoints(g) == endpoints(s));
+		auto within = [&](auto u, auto v) {
+			auto dx = position(u)[0] - position(v)[0], dy = position(u)[1] - position(v)[1];
+			return dx * dx + dy * dy <= radius * radius;
+		};
+		std::size_t expected = 0;
+		for (auto u : g.verts())
+			for (auto v : g.verts())
+				if (u != v && within(u, v))
+					++expected;
+		REQUIRE(2 * g.size() == expected);
+		for (auto e : g.edges())
+			REQUIRE(within(g.tail(e), g.head(e)));
+		// Too many points to compare every pair, unless the grid stays fine for a radius of zero
+		G h;
+		graph::generate_random_geometric(h, 200000, 0.0, r);
+		REQUIRE(h.order() == 200000);
+		REQUIRE(h.size() == 0);
+	}
+}
+
 #ifdef GRAPH_BENCHMARK
 TEST_CASE("atomic adjacency list", "[benchmark]") {
 	using G = graph::Atomic_out_adjacency_list;
@@ -6,6 +6,9 @@
 #include <random>
 #include <sstream>
 #include <set>
+#include <tuple>
+#include <vector>
+#include <algorithm>
 #include <range/v3/distance.hpp>
 #include <range/v3/algorithm/count.hpp>
 #include <range/v3/algorithm/sample.hpp>
@@ -123,6 +126,15 @@ struct Graph_tester {
 			REQUIRE(vs.contains(v));
 		}
 		REQUIRE(g.order() == ranges::distance(g.verts()));
+		// samples only come from the current verts
+		if (g.order()) {
+			std::mt19937 r;
+			REQUIRE(vs.contains(g.random_vert(r)));
+			auto sample = g.random_verts(r, 8);
+			REQUIRE(sample.size() == 8);
+			for (auto v : sample)
+				REQUIRE(vs.contains(v));
+		}
 	}
 	void require_edge_invariants() const {
 		for (auto e : g.edges()) {
@@ -131,6 +143,15 @@ struct Graph_tester {
 			REQUIRE(es.contains(e));
 		}
 		REQUIRE(g.size() == ranges::distance(g.edges()));
+		// samples only come from the current edges
+		if (g.size()) {
+			std::mt19937 r;
+			REQUIRE(es.contains(g.random_edge(r)));
+			auto sample = g.random_edges(r, 8);
+			REQUIRE(sample.size() == 8);
+			for (auto e : sample)
+				REQUIRE(es.contains(e));
+		}
 	}
 	void require_invariants() const {
 		require_vert_invariants();
@@ -397,3 +418,39 @@ struct Bi_edge_graph_tester :
 		_in_type::erase_edge_postconditions();
 	}
 };
+
+// Requires that `forest` is a minimum spanning forest of the undirected graph underlying `g`, by checking that each edge outside it closes a cycle on which it is heaviest.
+template <class G, class Forest, class Weight>
+void require_minimum_spanning_forest(const G& g, const Forest& forest, const Weight& weight) {
+	using W = std::decay_t<decltype(weight(std::declval<graph::Edge<G>>()))>;
+	auto incident = g.vert_map(std::vector<graph::Edge<G>>{});
+	for (auto e : g.edges()) {
+		if (forest.contains(e)) {
+			REQUIRE(g.tail(e) != g.head(e));
+			incident[g.tail(e)].push_back(e);
+			incident[g.head(e)].push_back(e);
+		}
+	}
+	// Each edge outside the forest must close a cycle on which it is heaviest
+	for (auto e : g.edges()) {
+		if (forest.contains(e) || g.tail(e) == g.head(e))
+			continue;
+		std::vector<std::tuple<graph::Vert<G>, graph::Edge<G>, W>> stack{{g.tail(e), g.null_edge(), W{}}};
+		// Reaching a vertex twice means the forest has a cycle
+		auto visited = g.vert_set();
+		bool found = false;
+		while (!stack.empty() && !found) {
+			auto [v, from, heaviest] = stack.back();
+			stack.pop_back();
+			REQUIRE(visited.insert(v));
+			if (v == g.head(e)) {
+				REQUIRE(heaviest <= weight(e));
+				found = true;
+			}
+			for (auto f : incident(v))
+				if (f != from)
+					stack.emplace_back(g.tail(f) == v ? g.head(f) : g.tail(f), f, std::max(heaviest, weight(f)));
+		}
+		REQUIRE(found);
+	}
+}
@@ -0,0 +1,78 @@
+
+#include <graph/Grid_graph.hpp>
+#include <graph/Stable_adjacency_list.hpp>
+
+#include "Graph_tester.hpp"
+
+SCENARIO("grid graphs behave properly", "[Grid_graph]") {
+	GIVEN("a two-dimensional grid") {
+		using G = graph::Grid_graph<2>;
+		using X = G::Coordinates;
+
+		WHEN("cells are adjacent along axes") {
+			G g(X{5, 7});
+			REQUIRE(g.order() == 35);
+			REQUIRE(g.size() == 2 * (4 * 7 + 5 * 6));
+			Bi_edge_graph_tester gt{g};
+			for (auto v : g.verts()) {
+				REQUIRE(g.vert(g.coordinates(v)) == v);
+				for (auto e : g.out_edges(v)) {
+					auto x = g.coordinates(v), y = g.coordinates(g.head(e));
+					REQUIRE((x[0] == y[0]) != (x[1] == y[1]));
+				}
+			}
+			REQUIRE(g.vert(X{5, 0}) == g.null_vert());
+			REQUIRE(g.out_degree(g.vert(X{0, 0})) == 2);
+			REQUIRE(g.out_degree(g.vert(X{2, 3})) == 4);
+		}
+		WHEN("cells are adjacent along diagonals") {
+			G g(X{5, 7}, graph::Grid_neighborhood::moore);
+			REQUIRE(g.size() == 2 * (4 * 7 + 5 * 6 + 2 * 4 * 6));
+			Bi_edge_graph_tester gt{g};
+			REQUIRE(g.out_degree(g.vert(X{2, 3})) == 8);
+		}
+		WHEN("some cells are blocked") {
+			// A wall with a gap at the bottom
+			std::vector<bool> blocked(25, false);
+			for (std::size_t i = 0; i < 4; ++i)
+				blocked[i * 5 + 2] = true;
+			G g(X{5, 5}, graph::Grid_neighborhood::von_neumann, blocked);
+			Bi_edge_graph_tester gt{g};
+			auto s = g.vert(X{0, 0}), t = g.vert(X{0, 4});
+			auto [tree, distance] = g.shortest_paths_from(s, [](const auto&) { return 1; });
+			REQUIRE(distance(t) == 12);
+			for (auto v : g.verts()) {
+				REQUIRE(g.is_blocked(v) == blocked[g.coordinates(v)[0] * 5 + g.coordinates(v)[1]]);
+				if (g.is_blocked(v)) {
+					REQUIRE(g.out_degree(v) == 0);
+					REQUIRE(g.in_degree(v) == 0);
+					REQUIRE(!tree.in_tree(v));
+				}
+			}
+			REQUIRE(g.shortest_path(s, t, [](const auto&) { return 1.0; }).size() == 12);
+		}
+		WHEN("taking a product with a stable adjacency list") {
+			G g(X{3, 3});
+			graph::Stable_bi_adjacency_list h;
+			auto u = h.insert_vert(), v = h.insert_vert();
+			h.insert_edge(u, v);
+			h.insert_edge(v, u);
+			auto product = graph::tensor_product_view(g, h);
+			using P = std::decay_t<decltype(product._impl())>;
+			// Grid edges are keyed sparsely, so only vertices are indexed densely
+			static_assert(P::_dense_verts && !P::_dense_edges);
+			Bi_edge_graph_tester pgt{ product };
+		}
+	}
+	GIVEN("a three-dimensional grid") {
+		using G = graph::Grid_graph<3>;
+		G g(G::Coordinates{3, 3, 3}, graph::Grid_neighborhood::moore);
+		REQUIRE(g.order() == 27);
+		REQUIRE(g.size() == 7 * 7 * 7 - 27);
+		REQUIRE(g.out_degree(g.vert({1, 1, 1})) == 26);
+		Bi_edge_graph_tester gt{g};
+		G h(G::Coordinates{3, 4, 5});
+		REQUIRE(h.size() == 2 * (2 * 4 * 5 + 3 * 3 * 5 + 3 * 4 * 4));
+		Bi_edge_graph_tester ht{h};
+	}
+}
@@ -4,6 +4,9 @@
 #include "Graph_tester.hpp"
 
 #include <numeric> // for std::accumulate
+#include <set>
+#include <map>
+#include <range/v3/algorithm/equal.hpp>
 
 SCENARIO("stable out-adjacency lists behave properly", "[Stable_out_adjacency_list]") {
 	using G = graph::Stable_out_adjacency_list;
@@ -57,6 +60,28 @@ SCENARIO("stable out-adjacency lists behave properly", "[Stable_out_adjacency_li
 			auto rg = g.reverse_view();
 			In_edge_graph_tester rgt{rg};
 		}
+		WHEN("viewed with a transpose") {
+			auto bg = g.bi_edge_view();
+			Bi_edge_graph_tester bgt{bg};
+			// Copies share the transpose
+			auto copy = bg;
+			for (auto v : g.verts())
+				REQUIRE(copy.in_edges(v).begin() == bg.in_edges(v).begin());
+			auto t = gt.random_vert(r);
+			auto weight = g.edge_map(0.0);
+			for (auto e : g.edges())
+				weight[e] = std::uniform_real_distribution<double>{}(r);
+			auto [tree, distances] = bg.shortest_paths_to(t, weight);
+			REQUIRE(tree.root() == t);
+			REQUIRE(distances(t) == 0);
+			for (auto v : g.verts()) {
+				auto e = tree.out_edge_or_null(v);
+				if (e != g.null_edge())
+					REQUIRE(distances(v) == distances(g.head(e)) + weight(e));
+			}
+			for (auto e : g.edges())
+				REQUIRE(!(distances(g.tail(e)) > distances(g.head(e)) + weight(e)));
+		}
 		WHEN("searching for shortest paths from a vertex") {
 			auto s = gt.random_vert(r);
 			auto weight = g.edge_map(0.0);
@@ -75,6 +100,96 @@ SCENARIO("stable out-adjacency lists behave properly", "[Stable_out_adjacency_li
 			for (auto e : g.edges())
 				REQUIRE(!(distances(g.head(e)) > distances(g.tail(e)) + weight(e)));
 		}
+		WHEN("indexing a shortest path tree") {
+			auto s = gt.random_vert(r);
+			auto weight = g.edge_map(0.0);
+			for (auto e : g.edges())
+				weight[e] = std::uniform_real_distribution<double>{}(r);
+			auto [tree, distances] = g.shortest_paths_from(s, weight);
+			auto index = tree.lca_index(weight);
+			auto ancestors = [&](auto v) {
+				std::vector<graph::Vert<G>> result{v};
+				for (graph::Edge<G> e; (e = tree.in_edge_or_null(v)) != g.null_edge(); result.push_back(v))
+					v = g.tail(e);
+				return result;
+			};
+			for (auto u : g.verts()) {
+				auto up = ancestors(u);
+				REQUIRE(index.depth(u) == up.size() - 1);
+				REQUIRE(index.root(u) == up.back());
+				if (index.root(u) == s)
+					REQUIRE(index.root_distance(u) == distances(u));
+				for (auto v : g.verts()) {
+					auto vp = ancestors(v);
+					if (up.back() != vp.back()) {
+						REQUIRE(index.lowest_common_ancestor(u, v) == g.null_vert());
+#if GRAPH_CHECK_PRECONDITIONS
+						REQUIRE_THROWS_AS(index.path_length(u, v), graph::precondition_unmet);
+#endif
+						continue;
+					}
+					// The deepest common ancestor is where the root paths last agree
+					auto i = up.size(), j = vp.size();
+					while (i > 0 && j > 0 && up[i - 1] == vp[j - 1])
+						--i, --j;
+					REQUIRE(index.lowest_common_ancestor(u, v) == up[i]);
+					REQUIRE(index.path_size(u, v) == i + j);
+					if (up.back() == s)
+						REQUIRE(index.path_length(u, v) == Approx(distances(u) + distances(v) - 2 * distances(up[i])));
+				}
+			}
+			auto unweighted = tree.lca_index();
+			for (auto v : g.verts())
+				REQUIRE(unweighted.depth(v) == index.depth(v));
+		}
+		WHEN("freezing a shortest path tree") {
+			auto s = gt.random_vert(r);
+			auto weight = g.edge_map(0.0);
+			for (auto e : g.edges())
+				weight[e] = std::uniform_real_distribution<double>{}(r);
+			auto [tree, distances] = g.shortest_paths_from(s, weight);
+			auto index = tree.forest_index();
+			std::size_t children = 0;
+			for (auto v : g.verts()) {
+				for (auto c : index.children(v)) {
+					REQUIRE(g.tail(tree.in_edge_or_null(c)) == v);
+					REQUIRE(index.parent(c) == v);
+					REQUIRE(index.depth(c) == index.depth(v) + 1);
+					++children;
+				}
+			}
+			REQUIRE(children == ranges::distance(tree.edges()));
+			for (auto v : index.roots())
+				REQUIRE(tree.in_edge_or_null(v) == g.null_edge());
+			auto pre = g.vert_map(std::size_t{}), post = g.vert_map(std::size_t{});
+			std::size_t i = 0;
+			for (auto v : index.pre_order())
+				pre[v] = i++;
+			REQUIRE(i == g.order());
+			i = 0;
+			for (auto v : index.post_order())
+				post[v] = i++;
+			auto sizes = index.subtree_sizes();
+			auto counts = index.subtree_aggregate([](auto) { return std::size_t{1}; });
+			auto depths = index.root_path_aggregate([&](auto v) {
+				return index.parent(v) == g.null_vert() ? 0.0 : weight(tree.in_edge_or_null(v));
+			});
+			for (auto v : g.verts()) {
+				REQUIRE(sizes(v) == index.subtree_size(v));
+				REQUIRE(counts(v) == sizes(v));
+				if (index.root(v) == s)
+					REQUIRE(depths(v) == distances(v));
+				auto p = index.parent(v);
+				if (p != g.null_vert()) {
+					REQUIRE(pre(p) < pre(v));
+					REQUIRE(post(v) < post(p));
+				}
+				std::size_t ancestors = 0;
+				for (auto u : g.verts())
+					ancestors += index.is_ancestor(u, v);
+				REQUIRE(ancestors == index.depth(v) + 1);
+			}
+		}
 		WHEN("searching for the shortest paths between all pairs of vertices") {
 			auto weight = [](auto e) { return 1.0; };
 			auto [trees, distances] = g.all_pairs_shortest_paths(weight);
@@ -82,6 +197,11 @@ SCENARIO("stable out-adjacency lists behave properly", "[Stable_out_adjacency_li
 			for (auto s : g.verts()) {
 				for (auto t : g.verts()) {
 					auto path = trees(s).path_from_root_to(t);
+					auto lazy = trees(s).lazy_path_from_root_to(t);
+					REQUIRE(g.is_null(lazy) == g.is_null(path));
+					REQUIRE(ranges::equal(lazy.edges(), path.edges()));
+					if (!g.is_null(lazy))
+						REQUIRE(ranges::equal(g.concatenate_paths(g.path(s), lazy).edges(), path.edges()));
 					if (g.is_null(path)) {
 						REQUIRE(distances(s)(t) >= g.order());
 					} else {
@@ -98,6 +218,544 @@ SCENARIO("stable out-adjacency lists behave properly", "[Stable_out_adjacency_li
 					REQUIRE(distances(s)(t) == distance_s(t));
 			}
 		}
+		WHEN("counting triangles") {
+			std::set<std::pair<graph::Vert<G>, graph::Vert<G>>> adjacent;
+			for (auto e : g.edges()) {
+				adjacent.emplace(g.tail(e), g.head(e));
+				adjacent.emplace(g.head(e), g.tail(e));
+			}
+			auto clustering = g.local_clustering();
+			std::size_t expected = 0;
+			for (auto u : g.verts()) {
+				std::size_t degree = 0, local = 0;
+				for (auto v : g.verts()) {
+					if (v == u || !adjacent.count({u, v}))
+						continue;
+					++degree;
+					for (auto w : g.verts())
+						if (v < w && w != u && adjacent.count({u, w}) && adjacent.count({v, w}))
+							++local;
+				}
+				expected += local;
+				if (degree > 1)
+					REQUIRE(clustering(u) == Approx(2.0 * local / (degree * (degree - 1))));
+				else
+					REQUIRE(clustering(u) == 0);
+			}
+			REQUIRE(g.count_triangles() == expected / 3);
+		}
+		WHEN("computing betweenness centrality") {
+			std::vector<graph::Vert<G>> verts;
+			for (auto v : g.verts())
+				verts.push_back(v);
+			const std::size_t n = verts.size(), inf = n;
+			auto index = g.vert_map(std::size_t{0});
+			for (std::size_t v = 0; v < n; ++v)
+				index[verts[v]] = v;
+			// Count shortest paths between every pair of vertices by brute force
+			std::vector<std::vector<double>> count(n, std::vector<double>(n, 0)), paths(n, std::vector<double>(n, 0));
+			std::vector<std::vector<std::size_t>> distance(n, std::vector<std::size_t>(n, inf));
+			for (auto e : g.edges())
+				if (g.tail(e) != g.head(e))
+					++count[index(g.tail(e))][index(g.head(e))];
+			for (std::size_t s = 0; s < n; ++s) {
+				distance[s][s] = 0;
+				paths[s][s] = 1;
+				for (std::size_t d = 0; d < n; ++d)
+					for (std::size_t u = 0; u < n; ++u)
+						if (distance[s][u] == d)
+							for (std::size_t t = 0; t < n; ++t)
+								if (count[u][t] && distance[s][t] >= d + 1) {
+									distance[s][t] = d + 1;
+									paths[s][t] += paths[s][u] * count[u][t];
+								}
+			}
+			auto centrality = g.betweenness_centrality();
+			auto weighted = g.betweenness_centrality([](auto) { return 1.0; });
+			auto sampled = g.betweenness_centrality(g.order(), r);
+			for (std::size_t v = 0; v < n; ++v) {
+				double expected = 0;
+				for (std::size_t s = 0; s < n; ++s)
+					for (std::size_t t = 0; t < n; ++t)
+						if (s != v && t != v && s != t && distance[s][t] < inf &&
+							distance[s][v] + distance[v][t] == distance[s][t])
+							expected += paths[s][v] * paths[v][t] / paths[s][t];
+				REQUIRE(centrality(verts[v]) == Approx(expected));
+				REQUIRE(weighted(verts[v]) == Approx(expected));
+				REQUIRE(sampled(verts[v]) == Approx(expected));
+			}
+			auto estimated = g.betweenness_centrality(g.order() / 2, r);
+			for (auto v : g.verts())
+				REQUIRE(estimated(v) >= 0);
+		}
+		WHEN("computing betweenness centrality with zero-length edges") {
+			// `b` precedes `a`, so it is settled first although it is also reached through the zero-length edge from `a`
+			G h;
+			auto s = h.insert_vert(), b = h.insert_vert(), a = h.insert_vert(), t = h.insert_vert();
+			auto length = h.edge_map(1.0);
+			h.insert_edge(s, a);
+			h.insert_edge(s, a);
+			h.insert_edge(s, b);
+			length[h.insert_edge(a, b)] = 0;
+			h.insert_edge(b, t);
+			// `a` lies on two of three shortest paths from `s` to each of `b` and `t`, and `b` on every path from `s` or `a` to `t`
+			auto centrality = h.betweenness_centrality(length);
+			REQUIRE(centrality(s) == Approx(0));
+			REQUIRE(centrality(a) == Approx(4.0 / 3));
+			REQUIRE(centrality(b) == Approx(2));
+			REQUIRE(centrality(t) == Approx(0));
+			length[h.insert_edge(b, a)] = 0;
+			REQUIRE_THROWS_AS(h.betweenness_centrality(length), graph::precondition_unmet);
+		}
+		WHEN("searching for the minimum spanning forest") {
+			auto weight = g.edge_map(0.0);
+			for (auto e : g.edges())
+				weight[e] = std::uniform_real_distribution<double>{}(r);
+			auto forest = g.minimum_spanning_forest(weight);
+			require_minimum_spanning_forest(g, forest, weight);
+		}
+		WHEN("searching for minimum arborescences") {
+			for (std::size_t trial = 0; trial < 20; ++trial) {
+				G h;
+				std::vector<graph::Vert<G>> verts;
+				for (std::size_t m = 0; m < 6; ++m)
+					verts.push_back(h.insert_vert());
+				auto weight = h.edge_map(0);
+				for (std::size_t n = 0; n < 14; ++n) {
+					auto e = h.insert_edge(h.random_vert(r), h.random_vert(r));
+					weight[e] = std::uniform_int_distribution(0, 9)(r);
+				}
+				auto s = verts[0];
+				auto tree = h.minimum_arborescence_from(s, weight);
+				auto reachable = h.vert_set();
+				std::vector<graph::Vert<G>> queue{s};
+				reachable.insert(s);
+				for (std::size_t i = 0; i < queue.size(); ++i)
+					for (auto e : h.out_edges(queue[i]))
+						if (reachable.insert(h.head(e)))
+							queue.push_back(h.head(e));
+				int total = 0;
+				for (auto v : h.verts()) {
+					REQUIRE(tree.in_tree(v) == reachable.contains(v));
+					auto e = tree.in_edge_or_null(v);
+					if (v != s && reachable.contains(v)) {
+						REQUIRE(h.head(e) == v);
+						total += weight(e);
+					}
+				}
+				// Find the optimal arborescence by trying every choice of incoming edges
+				std::vector<std::vector<graph::Edge<G>>> choices;
+				for (auto v : verts)
+					if (v != s && reachable.contains(v)) {
+						choices.emplace_back();
+						for (auto e : h.edges())
+							if (h.head(e) == v && h.tail(e) != v && reachable.contains(h.tail(e)))
+								choices.back().push_back(e);
+					}
+				int best = std::numeric_limits<int>::max();
+				std::vector<std::size_t> choice(choices.size(), 0);
+				for (;;) {
+					auto parent = h.vert_map(h.null_edge());
+					int sum = 0;
+					for (std::size_t i = 0; i < choices.size(); ++i) {
+						auto e = choices[i][choice[i]];
+						parent[h.head(e)] = e;
+						sum += weight(e);
+					}
+					bool acyclic = true;
+					for (auto v : verts) {
+						std::size_t steps = 0;
+						for (auto u = v; reachable.contains(u) && u != s && steps <= verts.size(); ++steps)
+							u = h.tail(parent(u));
+						acyclic = acyclic && steps <= verts.size();
+					}
+					if (acyclic)
+						best = std::min(best, sum);
+					std::size_t i = 0;
+					while (i < choices.size() && ++choice[i] == choices[i].size())
+						choice[i++] = 0;
+					if (i == choices.size())
+						break;
+				}
+				REQUIRE(total == best);
+			}
+		}
+		WHEN("detecting communities") {
+			// Build a ring of cliques, each joined to the next by a single edge
+			const std::size_t cliques = 4, clique_order = 6;
+			G h;
+			std::vector<graph::Vert<G>> verts;
+			for (std::size_t i = 0; i < cliques * clique_order; ++i)
+				verts.push_back(h.insert_vert());
+			for (std::size_t c = 0; c < cliques; ++c) {
+				for (std::size_t i = 0; i < clique_order; ++i)
+					for (std::size_t j = 0; j < i; ++j)
+						h.insert_edge(verts[c * clique_order + i], verts[c * clique_order + j]);
+				h.insert_edge(verts[c * clique_order], verts[(c + 1) % cliques * clique_order + 1]);
+			}
+			auto label_propagation = h.communities_label_propagation();
+			auto louvain = h.communities_louvain([](auto) { return 1.0; });
+			for (auto communities : {label_propagation, louvain}) {
+				for (std::size_t i = 0; i < verts.size(); ++i) {
+					REQUIRE(communities(verts[i]) < cliques);
+					REQUIRE(communities(verts[i]) == communities(verts[i / clique_order * clique_order + 2]));
+					if (i >= clique_order)
+						REQUIRE(communities(verts[i]) != communities(verts[i - clique_order]));
+				}
+			}
+			// Communities of the random graph must at least be numbered densely
+			auto communities = g.communities_louvain(g.edge_map(1.0));
+			std::set<std::size_t> seen;
+			for (auto v : g.verts())
+				seen.insert(communities(v));
+			REQUIRE(*seen.rbegin() + 1 == seen.size());
+		}
+		WHEN("coloring the graph") {
+			std::size_t max_degree = 0;
+			for (auto v : g.verts()) {
+				std::set<graph::Vert<G>> neighbors;
+				for (auto e : g.edges())
+					if (g.tail(e) != g.head(e) && (g.tail(e) == v || g.head(e) == v))
+						neighbors.insert(g.tail(e) == v ? g.head(e) : g.tail(e));
+				max_degree = std::max(max_degree, neighbors.size());
+			}
+			for (auto order : {graph::Coloring_order::natural, graph::Coloring_order::largest_first, graph::Coloring_order::smallest_last}) {
+				auto color = g.greedy_coloring(order);
+				for (auto v : g.verts())
+					REQUIRE(color(v) <= max_degree);
+				for (auto e : g.edges())
+					if (g.tail(e) != g.head(e))
+						REQUIRE(color(g.tail(e)) != color(g.head(e)));
+			}
+		}
+		WHEN("finding a maximum bipartite matching") {
+			auto left = g.vert_set();
+			for (auto v : g.verts())
+				if (std::bernoulli_distribution{}(r))
+					left.insert(v);
+			auto mate = g.maximum_bipartite_matching(left);
+			// Verify this is a matching
+			for (auto v : g.verts()) {
+				auto e = mate(v);
+				if (g.is_null(e))
+					continue;
+				REQUIRE((g.tail(e) == v || g.head(e) == v));
+				REQUIRE(left.contains(g.tail(e)));
+				REQUIRE(!left.contains(g.head(e)));
+				REQUIRE(mate(g.tail(e)) == e);
+				REQUIRE(mate(g.head(e)) == e);
+			}
+			// Verify there is no augmenting path
+			auto visited = g.vert_set();
+			std::vector<graph::Vert<G>> queue;
+			for (auto v : g.verts())
+				if (left.contains(v) && g.is_null(mate(v)) && visited.insert(v))
+					queue.push_back(v);
+			for (std::size_t i = 0; i < queue.size(); ++i) {
+				for (auto e : g.out_edges(queue[i])) {
+					auto v = g.head(e);
+					if (left.contains(v) || e == mate(queue[i]))
+						continue;
+					REQUIRE(!g.is_null(mate(v)));
+					auto w = g.tail(mate(v));
+					if (visited.insert(w))
+						queue.push_back(w);
+				}
+			}
+		}
+		WHEN("running random walks") {
+			std::set<std::pair<graph::Vert<G>, graph::Vert<G>>> weighted, any;
+			auto weight = g.edge_map(0.0);
+			for (auto e : g.edges()) {
+				weight[e] = std::bernoulli_distribution{}(r) ? 1.0 : 0.0;
+				any.emplace(g.tail(e), g.head(e));
+				if (weight(e) > 0)
+					weighted.emplace(g.tail(e), g.head(e));
+			}
+			const std::size_t k = 3, l = 8;
+			auto check = [&](const auto& walks, const auto& adjacent) {
+				REQUIRE(walks.size() == g.order() * k * (l + 1));
+				for (std::size_t w = 0; w < walks.size(); w += l + 1) {
+					REQUIRE(!g.is_null(walks[w]));
+					for (std::size_t i = w + 1; i <= w + l; ++i) {
+						if (g.is_null(walks[i])) {
+							// A walk only stops where it cannot continue
+							for (auto p : adjacent)
+								REQUIRE(p.first != walks[i - 1]);
+							for (; i <= w + l; ++i)
+								REQUIRE(g.is_null(walks[i]));
+							break;
+						}
+						REQUIRE(adjacent.count({walks[i - 1], walks[i]}));
+					}
+				}
+			};
+			check(g.random_walks(k, l, r), any);
+			check(g.random_walks(weight, k, l, r), weighted);
+			check(g.random_walks(weight, k, l, r, 0.25, 4.0), weighted);
+			check(g.random_walks(weight, k, l, r, 4.0, 0.25), weighted);
+		}
+		WHEN("sampling the steps of weighted random walks") {
+			G h;
+			auto a = h.insert_vert(), b = h.insert_vert(), c = h.insert_vert(), d = h.insert_vert();
+			auto weight = h.edge_map(0.0);
+			weight[h.insert_edge(a, b)] = 1;
+			weight[h.insert_edge(a, c)] = 2;
+			weight[h.insert_edge(a, d)] = 3;
+			weight[h.insert_edge(b, a)] = 1;
+			weight[h.insert_edge(b, c)] = 1;
+			using frequencies = std::map<graph::Vert<G>, double>;
+			auto require_near = [](frequencies& actual, const frequencies& expected) {
+				for (auto [v, x] : expected)
+					REQUIRE(actual[v] == Approx(x).margin(0.02));
+			};
+			const std::size_t k = 20000, l = 2;
+			for (auto [p, q] : {std::pair(1.0, 1.0), std::pair(4.0, 0.25), std::pair(0.25, 4.0)}) {
+				auto walks = h.random_walks(weight, k, l, r, p, q);
+				// Steps from `a` at the start of a walk, and after arriving from `b`
+				frequencies first, second;
+				std::size_t firsts = 0, seconds = 0;
+				for (std::size_t w = 0; w < walks.size(); w += l + 1) {
+					if (walks[w] == a)
+						++first[walks[w + 1]], ++firsts;
+					if (walks[w] == b && walks[w + 1] == a)
+						++second[walks[w + 2]], ++seconds;
+				}
+				for (auto& [v, f] : first)
+					f /= firsts;
+				for (auto& [v, f] : second)
+					f /= seconds;
+				// The first step follows the weights alone
+				require_near(first, {{b, 1.0 / 6}, {c, 2.0 / 6}, {d, 3.0 / 6}});
+				// The next weighs returning to `b` by 1 / p, moving to `c`, a neighbor of `b`, by 1, and moving away to `d` by 1 / q
+				auto total = 1 / p + 2 + 3 / q;
+				require_near(second, {{b, 1 / p / total}, {c, 2 / total}, {d, 3 / q / total}});
+			}
+		}
+		WHEN("reordering the graph") {
+			for (auto policy : {graph::Reorder_policy::reverse_cuthill_mckee, graph::Reorder_policy::descending_degree,
+				graph::Reorder_policy::breadth_first, graph::Reorder_policy::gorder}) {
+				auto [h, old_to_new, new_to_old, old_edge] = g.reorder(policy);
+				REQUIRE(h.order() == g.order());
+				REQUIRE(h.size() == g.size());
+				for (auto v : g.verts())
+					REQUIRE(new_to_old(old_to_new(v)) == v);
+				auto copied = g.edge_set();
+				for (auto f : h.edges()) {
+					auto e = old_edge(f);
+					REQUIRE(copied.insert(e));
+					REQUIRE(new_to_old(h.tail(f)) == g.tail(e));
+					REQUIRE(new_to_old(h.head(f)) == g.head(e));
+				}
+				for (auto v : h.verts())
+					REQUIRE(ranges::distance(h.out_edges(v)) == ranges::distance(g.out_edges(new_to_old(v))));
+			}
+			// Reverse Cuthill–McKee recovers the bandwidth of a path inserted in a random order
+			G path;
+			std::vector<graph::Vert<G>> verts;
+			for (std::size_t i = 0; i < 50; ++i)
+				verts.push_back(path.insert_vert());
+			std::shuffle(verts.begin(), verts.end(), r);
+			for (std::size_t i = 1; i < verts.size(); ++i)
+				path.insert_edge(verts[i - 1], verts[i]);
+			auto [h, old_to_new, new_to_old, old_edge] = path.reorder();
+			auto position = h.vert_map(std::size_t{});
+			std::size_t i = 0;
+			for (auto v : h.verts())
+				position[v] = i++;
+			for (auto e : h.edges())
+				REQUIRE((position(h.tail(e)) + 1 == position(h.head(e)) || position(h.head(e)) + 1 == position(h.tail(e))));
+		}
+		WHEN("partitioning the graph") {
+			for (std::size_t k = 1; k <= 5; ++k) {
+				auto [part, cut, part_weight] = g.partition(k);
+				REQUIRE(part_weight.size() == k);
+				double total = 0, expected_cut = 0;
+				for (auto w : part_weight) {
+					REQUIRE(w <= 1.1 * g.order() / k + 1);
+					total += w;
+				}
+				REQUIRE(total == g.order());
+				for (auto v : g.verts())
+					REQUIRE(part(v) < k);
+				for (auto e : g.edges())
+					if (part(g.tail(e)) != part(g.head(e)))
+						expected_cut += 1;
+				REQUIRE(cut == expected_cut);
+			}
+			// Two cliques joined by a single edge are split along it
+			G h;
+			std::vector<graph::Vert<G>> verts;
+			for (std::size_t i = 0; i < 20; ++i)
+				verts.push_back(h.insert_vert());
+			for (std::size_t i = 0; i < 20; ++i)
+				for (std::size_t j = i + 1; j < 20; ++j)
+					if (i / 10 == j / 10)
+						h.insert_edge(verts[i], verts[j]);
+			h.insert_edge(verts[3], verts[15]);
+			auto [part, cut, part_weight] = h.partition(2);
+			REQUIRE(cut == 1);
+			REQUIRE(part_weight == std::vector<double>{10, 10});
+			// Many small components, which matching alone cannot contract, are still split without cutting any of them
+			for (bool pairs : {false, true}) {
+				G sparse;
+				constexpr std::size_t n = 20000;
+				verts.clear();
+				for (std::size_t i = 0; i < n; ++i)
+					verts.push_back(sparse.insert_vert());
+				// Either a perfect matching, or a path through a tenth of the vertices with the rest isolated
+				for (std::size_t i = 1; i < (pairs ? n : n / 10); i += pairs ? 2 : 1)
+					sparse.insert_edge(verts[i - 1], verts[i]);
+				for (std::size_t k : {2, 3}) {
+					auto [part, cut, part_weight] = sparse.partition(k);
+					REQUIRE(cut <= 2);
+					for (auto w : part_weight)
+						REQUIRE(w <= 1.03 * n / k + 1);
+				}
+			}
+		}
+		WHEN("indexing reachability") {
+			// A sparse graph has many strongly connected components
+			G h;
+			std::vector<graph::Vert<G>> verts;
+			for (std::size_t i = 0; i < 200; ++i)
+				verts.push_back(h.insert_vert());
+			std::uniform_int_distribution<std::size_t> pick(0, verts.size() - 1);
+			for (std::size_t i = 0; i < 240; ++i)
+				h.insert_edge(verts[pick(r)], verts[pick(r)]);
+			for (auto [traversals, chunks] : {std::pair<std::size_t, std::size_t>{2, 1}, {0, 0}, {5, 4}}) {
+				auto index = h.reachability_index(traversals, chunks);
+				REQUIRE(index.components() > 1);
+				for (auto u : h.verts()) {
+					auto reached = h.vert_set();
+					std::vector<graph::Vert<G>> stack{u};
+					reached.insert(u);
+					while (!stack.empty()) {
+						auto x = stack.back();
+						stack.pop_back();
+						for (auto e : h.out_edges(x))
+							if (reached.insert(h.head(e)))
+								stack.push_back(h.head(e));
+					}
+					for (auto v : h.verts()) {
+						REQUIRE(index.reaches(u, v) == reached.contains(v));
+						if (index.component(u) == index.component(v))
+							REQUIRE(index.reaches(v, u));
+					}
+				}
+			}
+			auto index = g.reachability_index();
+			for (auto e : g.edges())
+				REQUIRE(index.reaches(g.tail(e), g.head(e)));
+		}
+		WHEN("querying regular paths") {
+			auto s = gt.random_vert(r);
+			auto label = g.edge_map(0);
+			for (auto e : g.edges())
+				label[e] = std::uniform_int_distribution<int>{0, 1}(r);
+			// Accepts alternating labels, starting with 0 and ending with 1
+			G states;
+			auto q0 = states.insert_vert(), q1 = states.insert_vert();
+			auto symbol = states.edge_map(0);
+			symbol[states.insert_edge(q0, q1)] = 0;
+			symbol[states.insert_edge(q1, q0)] = 1;
+			auto a = graph::automaton(states, q0, [q0](auto q) { return q == q0; }, std::cref(symbol));
+			auto matched = g.regular_path_query(s, a, label);
+			REQUIRE(matched.front() == s);
+			std::set<graph::Vert<G>> matched_set(matched.begin(), matched.end());
+			REQUIRE(matched_set.size() == matched.size());
+			// Breadth-first search over pairs of a vertex and the label the next edge must have
+			std::map<std::pair<graph::Vert<G>, int>, std::size_t> hops{{{s, 0}, 0}};
+			std::vector<std::pair<graph::Vert<G>, int>> pairs{{s, 0}};
+			for (std::size_t i = 0; i < pairs.size(); ++i) {
+				auto [v, l] = pairs[i];
+				for (auto e : g.out_edges(v))
+					if (label(e) == l && hops.emplace(std::pair(g.head(e), 1 - l), hops[pairs[i]] + 1).second)
+						pairs.emplace_back(g.head(e), 1 - l);
+			}
+			std::set<graph::Vert<G>> expected;
+			for (auto [p, h] : hops)
+				if (p.second == 0)
+					expected.insert(p.first);
+			REQUIRE(matched_set == expected);
+			auto unit = [](const auto&) { return 1; };
+			std::size_t previous = 0;
+			for (auto v : matched) {
+				auto path = g.regular_shortest_path(s, v, a, label, unit);
+				REQUIRE(!g.is_null(path));
+				REQUIRE(g.source(path) == s);
+				REQUIRE(g.target(path) == v);
+				auto edges = path.edges();
+				for (std::size_t i = 0; i < edges.size(); ++i)
+					REQUIRE(label(edges[i]) == static_cast<int>(i % 2));
+				REQUIRE(edges.size() % 2 == 0);
+				REQUIRE(edges.size() == hops[{v, 0}]);
+				// Matches are found in order of the fewest edges
+				REQUIRE(edges.size() >= previous);
+				previous = edges.size();
+			}
+			for (auto v : g.verts())
+				if (!matched_set.count(v))
+					REQUIRE(g.is_null(g.regular_shortest_path(s, v, a, label, unit)));
+
+			// A single accepting state with a transition for every label accepts every path
+			G any;
+			auto q = any.insert_vert();
+			auto any_symbol = any.edge_map(0);
+			any_symbol[any.insert_edge(q, q)] = 0;
+			any_symbol[any.insert_edge(q, q)] = 1;
+			auto any_accepting = any.vert_map(true);
+			auto b = graph::automaton(any, q, any_accepting, any_symbol);
+			auto weight = g.edge_map(0.0);
+			for (auto e : g.edges())
+				weight[e] = std::uniform_real_distribution<double>{}(r);
+			auto [tree, distance] = g.shortest_paths_from(s, weight);
+			REQUIRE(g.regular_path_query(s, b, label).size() == static_cast<std::size_t>(ranges::distance(tree.edges())) + 1);
+			for (auto v : g.verts()) {
+				auto path = g.regular_shortest_path(s, v, b, label, weight);
+				REQUIRE(g.is_null(path) == !tree.in_tree(v));
+				if (!g.is_null(path))
+					REQUIRE(path.total(weight) == Approx(distance(v)));
+			}
+		}
+		WHEN("computing core numbers") {
+			std::set<std::pair<graph::Vert<G>, graph::Vert<G>>> adjacent;
+			for (auto e : g.edges()) {
+				if (g.tail(e) == g.head(e))
+					continue;
+				adjacent.emplace(g.tail(e), g.head(e));
+				adjacent.emplace(g.head(e), g.tail(e));
+			}
+			auto core = g.core_numbers(), parallel_core = g.parallel_core_numbers();
+			// Repeatedly strip vertices of low degree to find each k-core
+			auto expected = g.vert_map(std::size_t{0});
+			for (std::size_t k = 1;; ++k) {
+				std::set<graph::Vert<G>> remaining;
+				for (auto v : g.verts())
+					if (expected(v) == k - 1)
+						remaining.insert(v);
+				for (bool changed = true; changed;) {
+					changed = false;
+					for (auto v : std::set<graph::Vert<G>>(remaining)) {
+						std::size_t degree = 0;
+						for (auto w : remaining)
+							degree += adjacent.count({v, w});
+						if (degree < k) {
+							remaining.erase(v);
+							changed = true;
+						}
+					}
+				}
+				if (remaining.empty())
+					break;
+				for (auto v : remaining)
+					expected[v] = k;
+			}
+			for (auto v : g.verts()) {
+				REQUIRE(core(v) == expected(v));
+				REQUIRE(parallel_core(v) == expected(v));
+			}
+		}
 	}
 	GIVEN("a complete out-adjacency list") {
 		std::mt19937 r;
@@ -133,6 +791,19 @@ SCENARIO("stable out-adjacency lists behave properly", "[Stable_out_adjacency_li
 				REQUIRE(!(distances(g.head(e)) > distances(g.tail(e)) + weight(e)));
 			}
 		}
+		WHEN("counting triangles") {
+			REQUIRE(g.count_triangles() == M * (M - 1) * (M - 2) / 6);
+			auto clustering = g.local_clustering();
+			for (auto v : g.verts())
+				REQUIRE(clustering(v) == Approx(1));
+		}
+		WHEN("computing core numbers") {
+			auto core = g.core_numbers(), parallel_core = g.parallel_core_numbers();
+			for (auto v : g.verts()) {
+				REQUIRE(core(v) == M - 1);
+				REQUIRE(parallel_core(v) == M - 1);
+			}
+		}
 	}
 }
 
@@ -296,6 +967,46 @@ SCENARIO("stable bi-adjacency lists behave properly", "[Stable_bi_adjacency_list
 			auto rg = g.reverse_view();
 			Bi_edge_graph_tester rgt{rg};
 		}
+		WHEN("filtered") {
+			auto kept_verts = g.ephemeral_vert_set();
+			for (auto v : g.verts())
+				if (std::bernoulli_distribution{0.75}(r))
+					kept_verts.insert(v);
+			auto kept_edges = g.edge_map(false);
+			for (auto e : g.edges())
+				kept_edges[e] = std::bernoulli_distribution{}(r);
+			auto fg = g.filtered_view(kept_verts, kept_edges);
+			Bi_edge_graph_tester fgt{fg};
+			auto kept = [&](auto e) { return kept_edges(e) && kept_verts.contains(g.tail(e)) && kept_verts.contains(g.head(e)); };
+			REQUIRE(fg.order() == kept_verts.size());
+			REQUIRE(fg.size() == static_cast<std::size_t>(ranges::distance(g.edges() | ranges::view::filter(kept))));
+			for (auto v : fg.verts()) {
+				REQUIRE(kept_verts.contains(v));
+				REQUIRE(ranges::distance(fg.out_edges(v)) == ranges::distance(g.out_edges(v) | ranges::view::filter(kept)));
+				REQUIRE(ranges::distance(fg.in_edges(v)) == ranges::distance(g.in_edges(v) | ranges::view::filter(kept)));
+			}
+			REQUIRE(g.filtered_view(graph::keep_all, graph::keep_all).size() == g.size());
+			REQUIRE(g.filtered_view(g.ephemeral_vert_set(), [](auto) { return true; }).order() == 0);
+			auto [h, old_to_new, new_to_old, old_edge] = fg.materialize();
+			REQUIRE(h.order() == fg.order());
+			REQUIRE(h.size() == fg.size());
+			for (auto v : fg.verts())
+				REQUIRE(new_to_old(old_to_new(v)) == v);
+			auto copied = g.edge_set();
+			for (auto f : h.edges()) {
+				auto e = old_edge(f);
+				REQUIRE(kept(e));
+				REQUIRE(copied.insert(e));
+				REQUIRE(new_to_old(h.tail(f)) == g.tail(e));
+				REQUIRE(new_to_old(h.head(f)) == g.head(e));
+			}
+			// The view refers to masks passed as lvalues, so it follows changes to them
+			if (fg.size()) {
+				auto size = fg.size();
+				kept_edges[*fg.edges().begin()] = false;
+				REQUIRE(fg.size() == size - 1);
+			}
+		}
 		WHEN("searching for the shortest path between vertices") {
 			auto weight = g.edge_map(0.0);
 			const double epsilon = 0.001;
@@ -316,6 +1027,15 @@ SCENARIO("stable bi-adjacency lists behave properly", "[Stable_bi_adjacency_list
 						// Verify this is the shortest path against Dijkstra's
 						auto path_distance = path.total(weight);
 						REQUIRE(path_distance <= distance(t) + epsilon * g.order());
+						// Verify the lazily gathered edges form the path
+						auto edges = path.edges();
+						REQUIRE(edges.size() == path.size());
+						auto v = s;
+						for (auto e : edges) {
+							REQUIRE(g.tail(e) == v);
+							v = g.head(e);
+						}
+						REQUIRE(v == t);
 					} else {
 						// Verify no path exists
 						REQUIRE(!tree.in_tree(t));
@@ -343,6 +1063,15 @@ SCENARIO("stable bi-adjacency lists behave properly", "[Stable_bi_adjacency_list
 						// Verify this is the shortest path against Dijkstra's
 						auto path_distance = path.total(weight);
 						REQUIRE(path_distance <= distance(t) + epsilon * g.order());
+						// Verify the lazily gathered edges form the path
+						auto edges = path.edges();
+						REQUIRE(edges.size() == path.size());
+						auto v = s;
+						for (auto e : edges) {
+							REQUIRE(g.tail(e) == v);
+							v = g.head(e);
+						}
+						REQUIRE(v == t);
 					} else {
 						// Verify no path exists
 						REQUIRE(!tree.in_tree(t));
@@ -350,6 +1079,36 @@ SCENARIO("stable bi-adjacency lists behave properly", "[Stable_bi_adjacency_list
 				}
 			}
 		}
+		WHEN("finding maximum flows between vertices") {
+			auto capacity = g.edge_map(0);
+			for (auto e : g.edges())
+				capacity[e] = std::uniform_int_distribution(0, 10)(r);
+			for (auto s : g.verts()) {
+				for (auto t : g.verts()) {
+					if (s == t)
+						continue;
+					auto [value, flow, cut] = g.max_flow(s, t, capacity);
+					REQUIRE(cut.contains(s));
+					REQUIRE(!cut.contains(t));
+					// Verify the flow is feasible and conserved
+					auto net = g.vert_map(0);
+					for (auto e : g.edges()) {
+						REQUIRE(flow(e) >= 0);
+						REQUIRE(flow(e) <= capacity(e));
+						net[g.tail(e)] -= flow(e);
+						net[g.head(e)] += flow(e);
+					}
+					for (auto v : g.verts())
+						REQUIRE(net(v) == (v == s ? -value : v == t ? value : 0));
+					// Verify the flow is maximum by comparing it to the capacity of the cut
+					int cut_capacity = 0;
+					for (auto e : g.edges())
+						if (cut.contains(g.tail(e)) && !cut.contains(g.head(e)))
+							cut_capacity += capacity(e);
+					REQUIRE(value == cut_capacity);
+				}
+			}
+		}
 	}
 }
 
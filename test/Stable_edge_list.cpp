@@ -55,6 +55,13 @@ SCENARIO("stable edge lists behave properly", "[Stable_edge_list]") {
 			auto rg = g.reverse_view();
 			Graph_tester rgt{rg};
 		}
+		WHEN("searching for the minimum spanning forest") {
+			auto weight = g.edge_map(0.0);
+			for (auto e : g.edges())
+				weight[e] = std::uniform_real_distribution<double>{}(r);
+			auto forest = g.minimum_spanning_forest(weight);
+			require_minimum_spanning_forest(g, forest, weight);
+		}
 	}
 }
 
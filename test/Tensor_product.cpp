@@ -1,9 +1,14 @@
 
 #include <graph/Edge_list.hpp>
+#include <graph/Adjacency_list.hpp>
+#include <graph/Stable_adjacency_list.hpp>
 
 #include "Graph_tester.hpp"
 
 #include <sstream>
+#include <set>
+#include <vector>
+#include <algorithm>
 
 SCENARIO("tensor products behave properly", "[Tensor_product]") {
 	GIVEN("two random edge lists") {
@@ -41,4 +46,170 @@ SCENARIO("tensor products behave properly", "[Tensor_product]") {
 			Graph_tester pgt{ product };
 		}
 	}
+	GIVEN("two random bi-adjacency lists") {
+		std::mt19937 r;
+		graph::Bi_adjacency_list g0, g1;
+		for (const auto ref : { std::ref(g0), std::ref(g1) }) {
+			auto& g = ref.get();
+			const std::size_t M = 5, N = 12;
+			for (std::size_t m = 0; m < M; ++m)
+				g.insert_vert();
+			for (std::size_t n = 0; n < N; ++n) {
+				auto s = g.random_vert(r), t = g.random_vert(r);
+				g.insert_edge(s, t);
+			}
+		}
+
+		WHEN("taking their product") {
+			auto product = graph::tensor_product_view(g0, g1);
+			Bi_edge_graph_tester pgt{ product };
+			// Searches run directly on the product, without materializing it
+			auto s = *product.verts().begin();
+			auto [tree, distance] = product.shortest_paths_from(s, [](const auto&) { return 1; });
+			for (auto e : product.edges())
+				if (tree.in_tree(product.tail(e)))
+					REQUIRE(distance(product.head(e)) <= distance(product.tail(e)) + 1);
+			for (auto v : product.verts())
+				if (v != s && tree.in_tree(v))
+					REQUIRE(distance(v) == distance(product.tail(tree.in_edge_or_null(v))) + 1);
+		}
+
+		WHEN("taking a product with an edge list") {
+			graph::Edge_list g2;
+			auto product = graph::tensor_product_view(g0, g2);
+			static_assert(!graph::impl::traits::has_out_edges<std::decay_t<decltype(product._impl())>>);
+		}
+	}
+	GIVEN("two random stable bi-adjacency lists") {
+		std::mt19937 r;
+		graph::Stable_bi_adjacency_list g0, g1;
+		for (const auto ref : { std::ref(g0), std::ref(g1) }) {
+			auto& g = ref.get();
+			const std::size_t M = 5, N = 12;
+			for (std::size_t m = 0; m < M; ++m)
+				g.insert_vert();
+			for (std::size_t n = 0; n < N; ++n) {
+				auto s = g.random_vert(r), t = g.random_vert(r);
+				g.insert_edge(s, t);
+			}
+		}
+
+		WHEN("taking their product") {
+			auto product = graph::tensor_product_view(g0, g1);
+			using P = std::decay_t<decltype(product._impl())>;
+			static_assert(P::_dense_verts && P::_dense_edges);
+			Bi_edge_graph_tester pgt{ product };
+			THEN("ephemeral maps and sets are dense") {
+				auto vm = product.ephemeral_vert_map(std::size_t{});
+				auto vs = product.ephemeral_vert_set();
+				std::size_t i = 0;
+				for (auto v : product.verts()) {
+					REQUIRE(vs.insert(v));
+					vm[v] = i++;
+				}
+				REQUIRE(vs.size() == product.order());
+				i = 0;
+				for (auto v : product.verts()) {
+					REQUIRE(vs.contains(v));
+					REQUIRE(vm(v) == i++);
+				}
+				auto em = product.ephemeral_edge_map(product.null_vert());
+				auto es = product.ephemeral_edge_set();
+				for (auto e : product.edges()) {
+					em[e] = product.head(e);
+					REQUIRE(es.insert(e));
+					REQUIRE(!es.insert(e));
+				}
+				for (auto e : product.edges())
+					REQUIRE(em(e) == product.head(e));
+				REQUIRE(es.size() == product.size());
+			}
+			THEN("dense ephemeral sets erase, reinsert, and clear keys") {
+				// Compares a set of `keys` against a set of their positions
+				auto check = [](auto& set, const auto& keys) {
+					std::set<std::size_t> model;
+					auto agrees = [&] {
+						REQUIRE(set.size() == model.size());
+						for (std::size_t i = 0; i < keys.size(); ++i)
+							REQUIRE(set.contains(keys[i]) == (model.count(i) > 0));
+						std::set<std::size_t> members;
+						for (const auto& k : set)
+							REQUIRE(members.insert(std::find(keys.begin(), keys.end(), k) - keys.begin()).second);
+						REQUIRE(members == model);
+					};
+					for (std::size_t i = 0; i < keys.size(); ++i) {
+						REQUIRE(set.insert(keys[i]));
+						model.insert(i);
+					}
+					agrees();
+					// The most recently inserted key is the last element
+					auto last = keys.size() - 1;
+					REQUIRE(set.erase(keys[last]));
+					REQUIRE(!set.erase(keys[last]));
+					model.erase(last);
+					agrees();
+					for (std::size_t i = 0; i < last; i += 2) {
+						REQUIRE(set.erase(keys[i]));
+						model.erase(i);
+					}
+					agrees();
+					for (std::size_t i = 0; i < keys.size(); ++i)
+						REQUIRE(set.insert(keys[i]) == model.insert(i).second);
+					agrees();
+					REQUIRE(set.erase(keys[last]));
+					model.erase(last);
+					agrees();
+					set.clear();
+					model.clear();
+					agrees();
+					REQUIRE(set.insert(keys[last]));
+					model.insert(last);
+					agrees();
+				};
+				auto vs = product.ephemeral_vert_set();
+				std::vector<std::decay_t<decltype(*product.verts().begin())>> verts;
+				for (auto v : product.verts())
+					verts.push_back(v);
+				check(vs, verts);
+				auto es = product.ephemeral_edge_set();
+				std::vector<std::decay_t<decltype(*product.edges().begin())>> edges;
+				for (auto e : product.edges())
+					edges.push_back(e);
+				check(es, edges);
+			}
+		}
+		WHEN("a factor grows while persistent maps and sets of their product are alive") {
+			auto product = graph::tensor_product_view(g0, g1);
+			auto vm = product.vert_map(std::size_t{});
+			auto vs = product.vert_set();
+			std::size_t i = 0;
+			for (auto v : product.verts()) {
+				vm[v] = ++i;
+				vs.insert(v);
+			}
+			auto em = product.edge_map(product.null_vert());
+			for (auto e : product.edges())
+				em[e] = product.head(e);
+			auto s = g0.insert_vert(), t = g1.insert_vert();
+			g0.insert_edge(s, s);
+			g1.insert_edge(t, t);
+			THEN("old keys keep their values and new keys are distinct") {
+				i = 0;
+				for (auto v : product.verts()) {
+					auto old = std::get<0>(v._tuple) != s && std::get<1>(v._tuple) != t;
+					REQUIRE(vs.contains(v) == old);
+					REQUIRE(vm(v) == (old ? ++i : 0));
+					if (!old) {
+						REQUIRE(vs.insert(v));
+						vm[v] = 0;
+					}
+				}
+				for (auto e : product.edges()) {
+					auto v = product.tail(e);
+					auto old = std::get<0>(v._tuple) != s && std::get<1>(v._tuple) != t;
+					REQUIRE(em(e) == (old ? product.head(e) : product.null_vert()));
+				}
+			}
+		}
+	}
 }